@@ -7,10 +7,11 @@
 #include <numeric>
 #include <ranges>
 #include <unordered_map>
+#include <vector>
 
 #include "testrunner/testrunner.h"
-#include "utils/read_file.hh"
-#include "utils/split.hh"
+#include "utils/line_stream.hh"
+#include "utils/parse_integers.hh"
 
 namespace Day1 {
 
@@ -19,13 +20,13 @@ namespace Day1 {
   auto left  = std::vector<int>{};
   auto right = std::vector<int>{};
 
-  const auto values = Utils::readLines(path)  //
-                      | std::views::transform([](const auto& line) {
-                          return Utils::split<int, 2>(line, "   ");
-                        });
-  for (const auto& [left_, right_] : values) {
-    left.push_back(left_);
-    right.push_back(right_);
+  const auto rows = Utils::parseIntegers<int>(Utils::LineStream{path});
+  left.reserve(rows.size());
+  right.reserve(rows.size());
+  for (const auto row : rows) {
+    if (row.size() < 2) continue;  // Blank lines
+    left.push_back(row.front());
+    right.push_back(row.back());
   }
 
   // Part 1 requires sorting; Part 2 doesn't care...
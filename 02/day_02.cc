@@ -7,22 +7,28 @@
 #include <cmath>
 #include <functional>
 #include <ranges>
+#include <span>
+#include <vector>
 
 #include "testrunner/testrunner.h"
-#include "utils/read_file.hh"
+#include "utils/line_stream.hh"
+#include "utils/parse_integers.hh"
 #include "utils/split.hh"
 
 namespace Day2 {
 
-[[nodiscard]] auto readReports(const std::filesystem::path& path) {
-  return Utils::readLines(path)  //
+[[nodiscard]] auto streamReports(const std::filesystem::path& path) {
+  return Utils::LineStream{path}  //
          | std::views::transform([](const auto& line) {
              return Utils::split<int>(line, " ");
-           })  //
-         | std::ranges::to<std::vector>();
+           });
+}
+
+[[nodiscard]] auto readReports(const std::filesystem::path& path) {
+  return Utils::parseIntegers<int>(Utils::LineStream{path});
 }
 
-[[nodiscard]] constexpr auto minmaxDifference(const std::vector<int>& record)
+[[nodiscard]] constexpr auto minmaxDifference(std::span<const int> record)
     -> std::ranges::minmax_result<int> {
   return std::ranges::minmax(record |
                              std::views::pairwise_transform(std::minus<int>{}));
@@ -36,10 +42,10 @@ namespace Day2 {
          and std::signbit(minmax.min) == std::signbit(minmax.max);
 }
 
-[[nodiscard]] auto safeReports(const auto& records) {
-  const auto validated = records                                    //
-                         | std::views::transform(minmaxDifference)  //
-                         | std::views::transform(isSafe);
+[[nodiscard]] auto safeReports(auto&& records) {
+  auto validated = std::forward<decltype(records)>(records)  //
+                   | std::views::transform(minmaxDifference)  //
+                   | std::views::transform(isSafe);
   return std::ranges::count(validated, true);
 }
 
@@ -47,7 +53,7 @@ namespace Day2 {
   constexpr auto validate = [](auto record) -> bool {
     for (int64_t skip_idx = 0; skip_idx != static_cast<int64_t>(record.size());
          ++skip_idx) {
-      auto copy = record;
+      auto copy = record | std::ranges::to<std::vector>();
       copy.erase(copy.begin() + skip_idx);
       const auto valid = isSafe(minmaxDifference(copy));
       if (valid) return true;
@@ -65,4 +71,5 @@ TEST(Day_02_RedNosed_Reports_SAMPLE) {
   const auto reports = Day2::readReports("02/sample.txt");
   EXPECT_EQ(Day2::safeReports(reports), 2);
   EXPECT_EQ(Day2::safeReportsWithTolerance(reports), 4);
+  EXPECT_EQ(Day2::safeReports(Day2::streamReports("02/sample.txt")), 2);
 }
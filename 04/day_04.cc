@@ -14,7 +14,7 @@
 
 namespace Day4 {
 
-using XmasGrid = Utils::Grid<char, Utils::OutOfBoundsPolicy::Default<char{}>>;
+using XmasGrid = Utils::Grid<char, Utils::OutOfBoundsPolicy::Halo<char{}>>;
 
 [[nodiscard]] auto makeGrid(const std::filesystem::path& path) -> XmasGrid {
   auto file = std::ifstream(path);
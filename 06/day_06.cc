@@ -3,10 +3,18 @@
 // https://adventofcode.com/2024/day/6
 //
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include "map.hh"
 #include "state.hh"
 #include "testrunner/testrunner.h"
+#include "utils/bit_grid.hh"
 #include "utils/coordinate.hh"
+#include "utils/coordinate_set.hh"
+#include "utils/coordinate_step.hh"
+#include "utils/coordinate_step_indexer.hh"
 #include "utils/read_file.hh"
 
 namespace Day6 {
@@ -28,9 +36,20 @@ void moveGuard(State& state) {
   state.guard.position = new_position;
 }
 
-[[nodiscard]] auto hasLooped(State& state) -> bool {
-  if (!state.visited.contains(state.guard.position)) state.travelled = 0;
-  return ++state.travelled == state.max_travel;
+// Walks the guard from wall to wall; it is in a loop once it turns the same
+// way at the same wall twice. turned is scratch space, one bit per Step.
+[[nodiscard]] auto walksInLoop(const Utils::BitGrid& walls,
+                               const Utils::StepIndexer& steps,
+                               std::vector<bool>& turned, Utils::Step guard)
+    -> bool {
+  turned.assign(steps.size(), false);
+  while (const auto wall = walls.nextSet(guard.position, guard.direction)) {
+    guard.position = *wall - guard.direction;
+    if (turned[steps(guard)]) return true;
+    turned[steps(guard)] = true;
+    guard.direction.rotateClockwise();
+  }
+  return false;
 }
 
 void spyOnTheGuard(State& state) {
@@ -39,18 +58,19 @@ void spyOnTheGuard(State& state) {
   // Part 1
   while (guardInBounds(state)) moveGuard(state);
 
-  // Part 2
-  state.switchToProbing();
-  while (!state.noMoreCandidates()) {
-    moveGuard(state);
-    if (!guardInBounds(state)) {
-      state.nextCandidate();
-
-    } else if (hasLooped(state)) {
+  // Part 2: an obstruction only matters on the path of the guard
+  auto walls       = state.map.walls();
+  const auto steps = Utils::StepIndexer{walls.width(), walls.height()};
+  auto turned      = std::vector<bool>{};
+  const auto start = Utils::Step{state.map.guard, Map::start_direction};
+  state.candidates = state.visited - Utils::CoordinateSet{state.map.guard};
+  for (const auto candidate : state.candidates) {
+    walls.set(candidate);
+    if (walksInLoop(walls, steps, turned, start))
       ++state.obstruction_positions;
-      state.nextCandidate();
-    }
+    walls.reset(candidate);
   }
+  state.candidates_attempted = state.candidates.count();
 }
 
 }  // namespace Day6
@@ -63,3 +83,47 @@ TEST(Day_06_Guard_Gallivant_SAMPLE) {
   EXPECT_EQ(state.candidates_attempted + 1, 41);
   EXPECT_EQ(state.obstruction_positions, 6);
 }
+
+TEST(Day_06_Guard_Gallivant_coordinate_set) {
+  const auto empty = Utils::CoordinateSet{};
+  EXPECT_EQ(empty.count(), 0);
+  EXPECT_TRUE(empty.empty());
+  EXPECT_TRUE(empty.begin() == empty.end());
+  EXPECT_FALSE(empty.contains(Utils::Coordinate{}));
+
+  // Rows of 10 cells: row 6 crosses from the first word into the second,
+  // which is the last and only partly used
+  const auto cells =
+      std::vector<Utils::Coordinate>{{0, 0}, {3, 6}, {4, 6}, {9, 9}};
+  auto set = Utils::CoordinateSet{std::from_range, cells, 10, 10};
+  EXPECT_EQ(set.count(), cells.size());
+  auto listed = size_t{};
+  for (const auto cell : set) {
+    EXPECT_EQ(cell, cells[std::min(listed, cells.size() - 1)]);
+    ++listed;
+  }
+  EXPECT_EQ(listed, cells.size());
+  EXPECT_EQ(set.count(Utils::Coordinate{0, 6}, Utils::Coordinate{10, 7}), 2);
+  EXPECT_EQ(set.count(Utils::Coordinate{4, 0}, Utils::Coordinate{10, 10}), 2);
+
+  // Aliased operands
+  set &= set;
+  EXPECT_EQ(set.count(), cells.size());
+  set |= set;
+  EXPECT_EQ(set.count(), cells.size());
+  auto gone = set;
+  gone -= gone;
+  EXPECT_TRUE(gone.empty());
+  EXPECT_EQ(gone.size(), set.size());
+
+  // A set of another shape combines cell by cell, growing as it must
+  const auto other = Utils::CoordinateSet{
+      std::from_range,
+      std::array{Utils::Coordinate{4, 6}, Utils::Coordinate{-5, 20}}};
+  EXPECT_EQ((set & other).count(), 1);
+  EXPECT_TRUE((set & other).contains(Utils::Coordinate{4, 6}));
+  EXPECT_EQ((set - other).count(), 3);
+  EXPECT_FALSE((set - other).contains(Utils::Coordinate{4, 6}));
+  EXPECT_EQ((set | other).count(), 5);
+  EXPECT_TRUE((set | other).contains(Utils::Coordinate{-5, 20}));
+}
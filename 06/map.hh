@@ -1,6 +1,7 @@
 #ifndef DAY_6_MAP_HH
 #define DAY_6_MAP_HH
 
+#include "utils/bit_grid.hh"
 #include "utils/coordinate.hh"
 #include "utils/coordinate_set.hh"
 
@@ -23,6 +24,13 @@ struct Map {
     if (chr == '^') guard = pos;
     if (chr == '#') blocked.insert(pos);
   }
+
+  [[nodiscard]] auto walls() const -> Utils::BitGrid {
+    auto bits = Utils::BitGrid{static_cast<size_t>(size.x),
+                               static_cast<size_t>(size.y)};
+    for (const auto at : blocked) bits.set(at);
+    return bits;
+  }
 };
 
 }  // namespace Day6
@@ -32,14 +32,13 @@ struct State {
   void resetGuard() {
     guard.position  = map.guard;
     guard.direction = Map::start_direction;
-    visited         = {};
-    travelled       = {};
+    visited.clear();
+    travelled = {};
   }
 
   void switchToProbing() {
-    max_travel = visited.count();
-    candidates = visited;
-    candidates.erase(map.guard);
+    max_travel     = visited.count();
+    candidates     = visited - Utils::CoordinateSet{map.guard};
     next_candidate = candidates.begin();
 
     mode         = Mode::Probing;
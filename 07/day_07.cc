@@ -8,25 +8,21 @@
 #include <algorithm>  // IWYU pragma: keep
 #include <array>
 #include <ranges>
-#include <vector>
+#include <span>
 
 #include "testrunner/testrunner.h"
-#include "utils/read_file.hh"
-#include "utils/split.hh"
+#include "utils/line_stream.hh"
+#include "utils/parse_integers.hh"
 #include "utils/sum.hh"
 
 namespace Day7 {
 
-using Equation  = std::vector<uint64_t>;
-using Equations = std::vector<Equation>;
+using Equation  = std::span<const uint64_t>;
+using Equations = Utils::IntegerRows<uint64_t>;
 
 [[nodiscard]] auto calibrationEquations(const std::filesystem::path& path)
     -> Equations {
-  return Utils::readLines(path)  //
-         | std::views::transform([](const auto& line) {
-             return Utils::split<uint64_t>(line, " ");
-           })  //
-         | std::ranges::to<std::vector>();
+  return Utils::parseIntegers<uint64_t>(Utils::LineStream{path});
 }
 
 // NOLINTNEXTLINE
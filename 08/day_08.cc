@@ -3,6 +3,7 @@
 // https://adventofcode.com/2024/day/8
 //
 
+#include <algorithm>
 #include <array>
 #include <fstream>
 #include <ranges>
@@ -13,6 +14,7 @@
 #include "utils/coordinate_set.hh"
 #include "utils/curry.hh"
 #include "utils/grid.hh"
+#include "utils/sparse_coordinate_set.hh"
 
 namespace Day8 {
 
@@ -44,7 +46,7 @@ using AntennaGrid = Utils::Grid<char>;
       | std::views::transform(Utils::uncurry(antinodes_for))   //
       | std::views::join                                       //
       | std::views::filter(in_bounds)                          //
-      | std::ranges::to<Utils::CoordinateSet>();
+      | std::ranges::to<Utils::CoordinateSet>(grid.width(), grid.height());
   return antinodes.count();
 }
 
@@ -78,7 +80,7 @@ using AntennaGrid = Utils::Grid<char>;
       | std::views::filter(Utils::uncurry(is_same_frequency))  //
       | std::views::transform(Utils::uncurry(antinodes_for))   //
       | std::views::join                                       //
-      | std::ranges::to<Utils::CoordinateSet>();
+      | std::ranges::to<Utils::CoordinateSet>(grid.width(), grid.height());
   return antinodes.count();
 }
 
@@ -90,3 +92,67 @@ TEST(Day_08_Resonant_Collinearity_SAMPLE) {
   EXPECT_EQ(Day8::antiNodes(grid), 14);
   EXPECT_EQ(Day8::harmonicAntiNodes(grid), 34);
 }
+
+TEST(Day_08_Resonant_Collinearity_sparse_set) {
+  // Far apart tiles, on both sides of the origin
+  const auto scattered = std::vector<Utils::Coordinate>{
+      {-300, -5}, {-1, -1}, {0, 0}, {255, 255}, {256, 0}, {100'000, -100'000}};
+  auto set = Utils::SparseCoordinateSet{std::from_range, scattered};
+  EXPECT_EQ(set.count(), scattered.size());
+  EXPECT_FALSE(set.contains(Utils::Coordinate{-2, -1}));
+  EXPECT_FALSE(set.contains(Utils::Coordinate{0, 256}));
+  auto listed = size_t{};
+  for (const auto coordinate : set) {
+    EXPECT_EQ(std::ranges::count(scattered, coordinate), 1);
+    ++listed;
+  }
+  EXPECT_EQ(listed, scattered.size());
+
+  // Rectangles across tile boundaries
+  EXPECT_EQ(set.count(Utils::Coordinate{-1, -1}, Utils::Coordinate{257, 1}),
+            3);
+  EXPECT_EQ(set.count(Utils::Coordinate{-300, -100'000},
+                      Utils::Coordinate{100'001, 256}),
+            scattered.size());
+
+  // An array past its limit becomes a bitmap, and optimize() turns a block
+  // of whole rows into a single run
+  auto block = Utils::SparseCoordinateSet{};
+  for (int y = 0; y != 20; ++y)
+    for (int x = 0; x != 256; ++x) block.insert(Utils::Coordinate{x, y});
+  EXPECT_EQ(block.bytes(), 256 * 256 / 8);
+  block.optimize();
+  EXPECT_EQ(block.bytes(), 2 * sizeof(uint16_t));
+  EXPECT_EQ(block.count(), 20 * 256);
+  EXPECT_EQ(block.count(Utils::Coordinate{10, 5}, Utils::Coordinate{20, 25}),
+            10 * 15);
+
+  // Runs split on erase; a bitmap that shrinks back becomes an array
+  block.erase(Utils::Coordinate{100, 10});
+  EXPECT_FALSE(block.contains(Utils::Coordinate{100, 10}));
+  EXPECT_TRUE(block.contains(Utils::Coordinate{101, 10}));
+  EXPECT_EQ(block.bytes(), 2 * 2 * sizeof(uint16_t));
+  auto spread     = Utils::SparseCoordinateSet{};
+  const auto cell = [](int idx) {
+    return Utils::Coordinate{(idx * 15) % 256, (idx * 15) / 256};
+  };
+  for (int idx = 0; idx != 4'100; ++idx) spread.insert(cell(idx));
+  EXPECT_EQ(spread.bytes(), 256 * 256 / 8);
+  for (int idx = 0; idx != 5; ++idx) spread.erase(cell(idx));
+  EXPECT_EQ(spread.count(), 4'095);
+  EXPECT_EQ(spread.bytes(), 4'095 * sizeof(uint16_t));
+  EXPECT_TRUE(spread.contains(cell(5)));
+
+  // Set algebra, aliased and across tiles
+  auto merged = set | block;
+  EXPECT_EQ(merged.count(), set.count() + block.count() - 1);
+  EXPECT_EQ((merged & set).count(), set.count());
+  EXPECT_EQ((merged - block).count(), set.count() - 1);
+  merged &= merged;
+  EXPECT_EQ(merged.count(), set.count() + block.count() - 1);
+  merged |= merged;
+  EXPECT_EQ(merged.count(), set.count() + block.count() - 1);
+  merged -= merged;
+  EXPECT_TRUE(merged.empty());
+  EXPECT_TRUE(merged.begin() == merged.end());
+}
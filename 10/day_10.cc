@@ -8,17 +8,29 @@
 #include <algorithm>  // IWYU pragma: keep
 #include <filesystem>
 #include <fstream>
+#include <unordered_set>
+#include <vector>
 
 #include "testrunner/testrunner.h"
 #include "utils/coordinate.hh"
+#include "utils/coordinate_map.hh"
+#include "utils/coordinate_directions.hh"
 #include "utils/coordinate_set.hh"
+#include "utils/coordinate_step.hh"
+#include "utils/coordinate_step_map.hh"
+#include "utils/dense_coordinate_map.hh"
+#include "utils/dense_step_map.hh"
+#include "utils/flat_map.hh"
 #include "utils/grid.hh"
 #include "utils/sum.hh"
 
 namespace Day10 {
 
 using ElevationGrid =
-    Utils::Grid<char, Utils::OutOfBoundsPolicy::Default<char{}>>;
+    Utils::Grid<char, Utils::OutOfBoundsPolicy::Halo<char{}>>;
+
+// Trails from each cell to the peaks, so that each cell is only counted once
+using Ratings = Utils::DenseCoordinateMap<size_t>;
 
 [[nodiscard]] auto makeGrid(const std::filesystem::path& path)
     -> ElevationGrid {
@@ -42,7 +54,9 @@ using ElevationGrid =
   };
 
   const auto unique_peaks = [&](auto peaks) {
-    return (peaks | std::ranges::to<Utils::CoordinateSet>()).count();
+    return (peaks | std::ranges::to<Utils::CoordinateSet>(grid.width(),
+                                                          grid.height()))
+        .count();
   };
 
   return Utils::sum(grid.coordinates()                      //
@@ -51,17 +65,22 @@ using ElevationGrid =
                     | std::views::transform(unique_peaks));
 }
 
-[[nodiscard]] constexpr auto trailRatings(const ElevationGrid& grid) -> size_t {
+[[nodiscard]] auto trailRatings(const ElevationGrid& grid) -> size_t {
   const auto is_head = [&](auto coordinate) { return grid[coordinate] == '0'; };
   const auto is_peak = [&](auto coordinate) { return grid[coordinate] == '9'; };
 
-  auto count_paths_to_top = [&](this auto self, auto from) {
-    if (is_peak(from)) return 1U;
-    return Utils::sum(from.neighborsUpDownLeftRight()  //
-                      | std::views::filter([&](auto to) {
-                          return (grid[to] - grid[from]) == 1;
-                        })  //
-                      | std::views::transform(self));
+  auto ratings            = Ratings{grid};
+  auto count_paths_to_top = [&](this auto self, auto from) -> size_t {
+    if (is_peak(from)) return 1;
+    if (const auto known = ratings.find(from); known != ratings.end())
+      return known->second;
+    const auto paths = Utils::sum(from.neighborsUpDownLeftRight()  //
+                                  | std::views::filter([&](auto to) {
+                                      return (grid[to] - grid[from]) == 1;
+                                    })  //
+                                  | std::views::transform(self));
+    ratings.try_emplace(from, paths);
+    return paths;
   };
 
   return Utils::sum(grid.coordinates()             //
@@ -76,3 +95,105 @@ TEST(Day_10_Hoof_It_SAMPLE) {
   EXPECT_EQ(Day10::reachablePeaks(grid), 36);
   EXPECT_EQ(Day10::trailRatings(grid), 81);
 }
+
+// A hash that puts every key in the same group, so that every probe runs
+// on through the following groups and wraps around the end of the table
+struct CollidingHash {
+  [[nodiscard]] auto operator()(int /*unused*/) const -> size_t { return 0; }
+};
+
+TEST(Day_10_Hoof_It_flat_map) {
+  auto map = Utils::FlatMap<int, int, CollidingHash>{};
+  for (int key = 0; key != 100; ++key) map[key] = key * 2;
+  EXPECT_EQ(map.size(), 100);
+  for (int key = 0; key != 100; ++key) EXPECT_EQ(map.at(key), key * 2);
+
+  // Erased keys leave tombstones that lookups probe past; inserting again
+  // reuses them, and growing drops them
+  for (int key = 0; key < 100; key += 2) EXPECT_EQ(map.erase(key), 1);
+  EXPECT_EQ(map.erase(0), 0);
+  EXPECT_EQ(map.size(), 50);
+  EXPECT_FALSE(map.contains(50));
+  EXPECT_TRUE(map.contains(51));
+  for (int key = 0; key < 100; key += 2) map.try_emplace(key, -key);
+  for (int key = 100; key != 300; ++key) map.try_emplace(key, key);
+  EXPECT_EQ(map.size(), 300);
+  for (int key = 0; key != 100; ++key)
+    EXPECT_EQ(map.at(key), key % 2 == 0 ? -key : key * 2);
+  auto total = 0;
+  for (const auto& [key, value] : map) total += key;
+  EXPECT_EQ(total, 299 * 300 / 2);
+
+  // Copies are independent
+  auto copy = map;
+  copy.erase(1);
+  copy[2] = 0;
+  EXPECT_EQ(copy.size(), 299);
+  EXPECT_EQ(map.at(1), 2);
+  EXPECT_EQ(map.at(2), -2);
+
+  // Mirrored and diagonal coordinates, and steps that differ only in their
+  // direction, no longer hash alike
+  auto hashes = std::unordered_set<size_t>{};
+  for (int i = -50; i != 50; ++i) {
+    hashes.insert(Utils::CoordinateHash{}(Utils::Coordinate{i, i}));
+    hashes.insert(Utils::CoordinateHash{}(Utils::Coordinate{i, -i}));
+    hashes.insert(Utils::CoordinateHash{}(Utils::Coordinate{i, i + 7}));
+    hashes.insert(Utils::CoordinateHash{}(Utils::Coordinate{i + 7, i}));
+  }
+  EXPECT_EQ(hashes.size(), 4 * 100 - 1);  // (0, 0) is on both diagonals
+  hashes.clear();
+  const auto position = Utils::Coordinate{3, 4};
+  for (const auto direction : Utils::Directions::orthogonal()) {
+    hashes.insert(Utils::StepHash{}(Utils::Step{position, direction}));
+    hashes.insert(Utils::StepHash{}(Utils::Step{direction, position}));
+  }
+  EXPECT_EQ(hashes.size(), 8);
+}
+
+TEST(Day_10_Hoof_It_dense_map) {
+  const auto grid = Day10::makeGrid("10/sample.txt");
+  auto map        = Utils::DenseCoordinateMap<int, -1>{grid};
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.begin() == map.end());
+
+  // Cells holding the sentinel are absent, as is anything off the grid
+  EXPECT_EQ(map.unset(), -1);
+  EXPECT_TRUE(map.try_emplace(Utils::Coordinate{3, 1}, 5).second);
+  EXPECT_FALSE(map.try_emplace(Utils::Coordinate{3, 1}, 6).second);
+  map[Utils::Coordinate{0, 0}]  = 0;
+  map[Utils::Coordinate{7, 7}] += 2;
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_TRUE(map.contains(Utils::Coordinate{0, 0}));
+  EXPECT_FALSE(map.contains(Utils::Coordinate{1, 0}));
+  EXPECT_FALSE(map.contains(Utils::Coordinate{-1, 0}));
+  EXPECT_FALSE(map.contains(Utils::Coordinate{8, 0}));
+  EXPECT_TRUE(map.find(Utils::Coordinate{8, 0}) == map.end());
+  EXPECT_EQ(map.find(Utils::Coordinate{3, 1})->second, 5);
+  EXPECT_EQ(map.at(Utils::Coordinate{7, 7}), 2);
+  EXPECT_EQ(map.erase(Utils::Coordinate{0, 0}), 1);
+  EXPECT_EQ(map.erase(Utils::Coordinate{0, 0}), 0);
+  EXPECT_FALSE(map.contains(Utils::Coordinate{0, 0}));
+
+  // Iteration is in row major order, and writes through to the map
+  for (auto [coordinate, value] : map) value += coordinate.x;
+  auto seen = std::vector<Utils::Coordinate>{};
+  for (const auto& [coordinate, value] : map) seen.push_back(coordinate);
+  EXPECT_TRUE((seen == std::vector<Utils::Coordinate>{{3, 1}, {7, 7}}));
+  EXPECT_EQ(map.at(Utils::Coordinate{3, 1}), 8);
+  EXPECT_EQ(map.at(Utils::Coordinate{7, 7}), 9);
+
+  auto steps = Utils::DenseStepMap<size_t>{grid};
+  for (const auto direction : Utils::Directions::orthogonal())
+    steps[Utils::Step{Utils::Coordinate{2, 5}, direction}] = 1;
+  EXPECT_EQ(steps.size(), 4);
+  EXPECT_FALSE(steps.contains(Utils::Step{{2, 5}, {1, 1}}));
+  EXPECT_FALSE(steps.contains(Utils::Step{{2, 8}, {1, 0}}));
+  auto directions = std::vector<Utils::Coordinate>{};
+  for (const auto& [step, count] : steps) {
+    EXPECT_EQ(step.position, (Utils::Coordinate{2, 5}));
+    directions.push_back(step.direction);
+  }
+  EXPECT_TRUE(std::ranges::equal(directions,
+                                 Utils::Directions::orthogonal()));
+}
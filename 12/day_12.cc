@@ -20,7 +20,7 @@
 
 namespace Day12 {
 
-using GardenGrid = Utils::Grid<char, Utils::OutOfBoundsPolicy::Default<char{}>>;
+using GardenGrid = Utils::Grid<char, Utils::OutOfBoundsPolicy::Halo<char{}>>;
 
 [[nodiscard]] auto makeGrid(const std::filesystem::path& path) -> GardenGrid {
   auto file = std::ifstream(path);
@@ -40,11 +40,11 @@ void expandPatch(const GardenGrid& grid, Utils::Coordinate from,
 
 [[nodiscard]] auto patches(const GardenGrid& grid)
     -> std::vector<Utils::CoordinateSet> {
-  auto seen         = Utils::CoordinateSet{};
+  auto seen         = Utils::CoordinateSet{grid.width(), grid.height()};
   const auto unseen = [&](auto tile) { return !seen[tile]; };
 
   const auto make_patch = [&](auto from) {
-    auto patch = Utils::CoordinateSet{};
+    auto patch = Utils::CoordinateSet{grid.width(), grid.height()};
     expandPatch(grid, from, &patch, &seen);
     return patch;
   };
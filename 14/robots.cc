@@ -4,7 +4,7 @@
 
 #include <filesystem>
 #include <ranges>
-#include <string>
+#include <string_view>
 #include <vector>
 
 #include "external/ctre.hpp"
@@ -14,7 +14,7 @@
 
 namespace Day14::Internal {
 
-[[nodiscard]] auto buildRobot(const std::string& line) -> Robot {
+[[nodiscard]] auto buildRobot(std::string_view line) -> Robot {
   using namespace ctre::literals;  // NOLINT
   auto [_, px, py, vx, vy] =
       ctre::match<R"(p=(\d+),(\d+)\s+v=(-?\d+),(-?\d+))">(line);
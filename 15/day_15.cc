@@ -3,12 +3,12 @@
 // https://adventofcode.com/2024/day/15
 //
 
-#include <fstream>
-
 #include "testrunner/testrunner.h"
 #include "utils/coordinate.hh"
 #include "utils/coordinate_directions.hh"
 #include "utils/grid.hh"
+#include "utils/grid_view.hh"
+#include "utils/mapped_file.hh"
 #include "utils/one_of.hh"
 #include "utils/read_file.hh"
 #include "utils/sum.hh"
@@ -18,18 +18,24 @@ namespace Day15 {
 using Utils::Coordinate;
 using Utils::Direction;
 
-using Map   = Utils::Grid<char>;
-using Moves = std::vector<char>;
+using Map     = Utils::Grid<char>;
+using MapView = Utils::GridView<const char>;
+using Moves   = std::vector<char>;
 
+// The map is read in place from its file, and only copied to move the boxes
 struct Instructions {
-  Map map;
+  Utils::MappedFile map_file;
+  MapView map;
   Moves moves;
 };
 
 [[nodiscard]] auto readInstructions(const std::string& prefix) -> Instructions {
-  auto map_file = std::ifstream(prefix + "_map.txt");
-  return {.map   = Map::from(map_file),
-          .moves = Utils::readFile(prefix + "_moves.txt")};
+  auto map_file  = Utils::readFile(prefix + "_map.txt");
+  const auto map = MapView::from(map_file);
+  return {.map_file = std::move(map_file),
+          .map      = map,
+          .moves    = Utils::readFile(prefix + "_moves.txt") |
+                   std::ranges::to<Moves>()};
 }
 
 [[nodiscard]] constexpr auto directionFrom(char chr) -> Utils::Coordinate {
@@ -43,7 +49,7 @@ struct Instructions {
   // clang-format on
 }
 
-[[nodiscard]] auto doubleUp(const Map& in) -> Map {
+[[nodiscard]] auto doubleUp(const MapView& in) -> Map {
   auto out = Map{in.width() * 2, in.height()};
   for (const auto at : in.coordinates()) {
     const auto out_at   = Coordinate{at.x * 2, at.y};
@@ -127,12 +133,11 @@ constexpr auto move(Map& map, Coordinate from,
   return from;
 }
 
-[[nodiscard]] auto moveRobots(Instructions& instructions) {
-  auto robot = instructions.map.find('@').value_or(Utils::Coordinate{});
-  for (const auto& step : instructions.moves) {
+void moveRobots(Map& map, const Moves& moves) {
+  auto robot = map.find('@').value_or(Utils::Coordinate{});
+  for (const auto& step : moves) {
     if (const auto direction = directionFrom(step); !direction.isZero()) {
-      if (canMove(instructions.map, robot, direction))
-        robot = move(instructions.map, robot, direction);
+      if (canMove(map, robot, direction)) robot = move(map, robot, direction);
     }
   }
 }
@@ -145,15 +150,16 @@ constexpr auto move(Map& map, Coordinate from,
                     | std::views::transform(gps_score));
 }
 
-[[nodiscard]] auto warehouseOneScore(Instructions instructions) -> int {
-  moveRobots(instructions);
-  return gpsScore(instructions.map);
+[[nodiscard]] auto warehouseOneScore(const Instructions& instructions) -> int {
+  auto map = instructions.map.toGrid();
+  moveRobots(map, instructions.moves);
+  return gpsScore(map);
 }
 
-[[nodiscard]] auto warehouseTwoScore(Instructions instructions) -> int {
-  instructions.map = doubleUp(instructions.map);
-  moveRobots(instructions);
-  return gpsScore(instructions.map);
+[[nodiscard]] auto warehouseTwoScore(const Instructions& instructions) -> int {
+  auto map = doubleUp(instructions.map);
+  moveRobots(map, instructions.moves);
+  return gpsScore(map);
 }
 
 }  // namespace Day15
@@ -163,3 +169,11 @@ TEST(Day_15_Warehouse_Woes_SAMPLE) {
   EXPECT_EQ(Day15::warehouseOneScore(instructions), 10092);
   EXPECT_EQ(Day15::warehouseTwoScore(instructions), 9021);
 }
+
+// The last row of a view need not end in a newline
+TEST(Day_15_Warehouse_Woes_view) {
+  EXPECT_EQ(Day15::MapView::from("#.#\n#.#\n").height(), 2U);
+  EXPECT_EQ(Day15::MapView::from("#.#\n#.#").height(), 2U);
+  EXPECT_EQ(Day15::MapView::from("#.#\n#.").height(), 1U);
+  EXPECT_EQ(Day15::MapView::from("").height(), 0U);
+}
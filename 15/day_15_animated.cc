@@ -29,7 +29,8 @@ struct Instructions {
 [[nodiscard]] auto readInstructions(const std::string& prefix) -> Instructions {
   auto map_file = std::ifstream(prefix + "_map.txt");
   return {.map   = Map::from(map_file),
-          .moves = Utils::readFile(prefix + "_moves.txt")};
+          .moves = Utils::readFile(prefix + "_moves.txt") |
+                   std::ranges::to<Moves>()};
 }
 
 [[nodiscard]] constexpr auto directionFrom(char chr) -> Utils::Coordinate {
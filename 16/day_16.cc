@@ -4,90 +4,102 @@
 //
 
 #include <algorithm>  // IWYU pragma: keep
+#include <array>
 #include <filesystem>
 #include <fstream>
-#include <limits>
-#include <vector>
+#include <ranges>
 
 #include "testrunner/testrunner.h"
 #include "utils/coordinate.hh"
 #include "utils/coordinate_directions.hh"
 #include "utils/coordinate_set.hh"
 #include "utils/coordinate_step.hh"
-#include "utils/coordinate_step_map.hh"  // IWYU pragma: keep
+#include "utils/coordinate_step_indexer.hh"
+#include "utils/corridor_graph.hh"
+#include "utils/delta_stepping.hh"
+#include "utils/dijkstra_queues.hh"
 #include "utils/dijkstras.hh"
 #include "utils/grid.hh"
+#include "utils/inplace_vector.hh"
 
 namespace Day16 {
 
-using Map  = Utils::Grid<char>;
-using Edge = Utils::WeightedEdge<int, Utils::Step>;
+using Map       = Utils::Grid<char>;
+using Edge      = Utils::WeightedEdge<int, Utils::Step>;
+using Corridors = Utils::CorridorGraph<int>;
+
+constexpr auto TURN_COST = 1000;
 
 [[nodiscard]] auto loadMap(const std::filesystem::path& path) -> Map {
   auto map_file = std::ifstream(path);
   return Map::from(map_file);
 }
 
-[[nodiscard]] auto findPath(const Map& map) {
+[[nodiscard]] auto startEdge(const Map& map) -> Edge {
   const auto start = map.find('S').value_or(Utils::Coordinate{});
-  const auto start_edge =
-      Edge{0, Utils::Step{start, Utils::Direction::right()}};
-
-  const auto adjacent = [&](const auto& from) {
-    const auto edges = {
-        Edge{1, {from.next(), from.direction}},
-        {1000, {from.position, Utils::rotatedCounterClockwise(from.direction)}},
-        {1000, {from.position, Utils::rotatedClockwise(from.direction)}}};
-    const auto in_bounds = [&](auto to) {
-      return map[to.distance == 1 ? from.next() : to.edge.next()] != '#';
-    };
-    return edges | std::views::filter(in_bounds) |
-           std::ranges::to<std::vector>();
-  };
+  return Edge{0, Utils::Step{start, Utils::Direction::right()}};
+}
 
-  return Utils::dijkstra<int, Utils::Step>(start_edge, adjacent);
+[[nodiscard]] auto finishOf(const Map& map) -> Utils::Coordinate {
+  return map.find('E').value_or(Utils::Coordinate{});
 }
 
-[[nodiscard]] constexpr auto bestSeats(Utils::Step finish,
-                                       const auto& previous) -> size_t {
-  auto stack   = std::vector<Utils::Step>{finish};
-  auto visited = std::unordered_set<Utils::Step>{finish};
-  auto unique  = Utils::CoordinateSet{finish.position};
-  while (!stack.empty() and previous.contains(stack.front())) {
-    const auto to = stack.front();
-    stack.erase(stack.begin());
-
-    for (const auto& previous_edge : previous.at(to)) {
-      if (!visited.contains(previous_edge)) {
-        visited.insert(previous_edge);
-        stack.push_back(previous_edge);
-        unique.insert(previous_edge.position);
-      }
+// Searches only visit the junctions of the maze (and the start and finish)
+[[nodiscard]] auto corridorsOf(const Map& map) -> Corridors {
+  const auto open = [](char tile) { return tile != '#'; };
+  return Corridors{map, open,
+                   std::array{startEdge(map).edge.position, finishOf(map)}};
+}
+
+// One state per cell and heading: step forward, or turn on the spot towards
+// an open cell. The corridor graph contracts this model.
+[[nodiscard]] auto cellSteps(const Map& map) {
+  return [&map](const Utils::Step& from) {
+    auto edges = Utils::InplaceVector<Edge, 3>{};
+    if (map[from.next()] != '#')
+      edges.push_back(Edge{1, Utils::Step{from.next(), from.direction}});
+    for (const auto turned : {Utils::rotatedCounterClockwise(from.direction),
+                              Utils::rotatedClockwise(from.direction)}) {
+      const auto to = Utils::Step{from.position, turned};
+      if (map[to.next()] != '#') edges.push_back(Edge{TURN_COST, to});
     }
-  }
-  return unique.count();
+    return edges;
+  };
 }
 
-[[nodiscard]] auto runMaze(const Map& map) -> std::pair<int, size_t> {
-  const auto [distances, previous] = findPath(map);
+[[nodiscard]] auto findPath(const Map& map, const Corridors& corridors) {
+  return Utils::dijkstra<int, Utils::Step>(startEdge(map),
+                                           corridors.steps(TURN_COST),
+                                           corridors.stepIndexer());
+}
 
-  const auto finish    = map.find('E').value_or(Utils::Coordinate{});
-  const auto is_finish = [&](auto weighted) {
-    return std::get<0>(weighted).position == finish;
-  };
+[[nodiscard]] auto bestSeats(Utils::Step finish, const Corridors& corridors,
+                             const auto& paths) -> size_t {
+  const auto seats =
+      corridors.cellsOnShortestPaths(paths, std::array{finish}, TURN_COST);
+  return Utils::CoordinateSet{std::from_range, seats}.count();
+}
 
-  const auto lowest = [](auto acc, auto edge) -> std::pair<Utils::Step, int> {
-    if (edge.second < acc.second) return edge;
-    return acc;
+// The finish may be reached facing any direction; the closest one counts
+[[nodiscard]] auto closestFinish(const Map& map, const auto& paths)
+    -> Utils::Step {
+  const auto finish    = finishOf(map);
+  const auto to_finish = [&](auto direction) {
+    return Utils::Step{finish, direction};
   };
+  const auto by_distance = [&](auto step) { return paths.distance(step); };
 
-  const auto init =
-      std::make_pair(Utils::Step{}, std::numeric_limits<int>::max());
+  return std::ranges::min(
+      Utils::Directions::orthogonal() | std::views::transform(to_finish), {},
+      by_distance);
+}
 
-  auto finishes = distances | std::views::filter(is_finish);
-  const auto [min_at, min_distance] =
-      std::ranges::fold_left(finishes, init, lowest);
-  return std::make_pair(min_distance, bestSeats(min_at, previous));
+[[nodiscard]] auto runMaze(const Map& map) -> std::pair<int, size_t> {
+  const auto corridors = corridorsOf(map);
+  const auto paths     = findPath(map, corridors);
+  const auto min_at    = closestFinish(map, paths);
+  return std::make_pair(paths.distance(min_at),
+                        bestSeats(min_at, corridors, paths));
 }
 
 }  // namespace Day16
@@ -98,3 +110,80 @@ TEST(Day_16_Reindeer_Maze_SAMPLE) {
   EXPECT_EQ(distance, 11'048);
   EXPECT_EQ(best_seats, 64);
 }
+
+TEST(Day_16_Reindeer_Maze_cells_SAMPLE) {
+  const auto map   = Day16::loadMap("16/sample.txt");
+  const auto paths = Utils::dijkstra<int, Utils::Step>(
+      Day16::startEdge(map), Day16::cellSteps(map), Utils::StepIndexer{map});
+  EXPECT_EQ(paths.distance(Day16::closestFinish(map, paths)), 11'048);
+}
+
+// The corridor graph contracts the per-cell model, so the two agree on every
+// junction state and on the seats
+TEST(Day_16_Reindeer_Maze_corridors_SAMPLE) {
+  const auto map        = Day16::loadMap("16/sample.txt");
+  const auto corridors  = Day16::corridorsOf(map);
+  const auto contracted = Day16::findPath(map, corridors);
+  const auto cells      = Utils::dijkstra<int, Utils::Step>(
+      Day16::startEdge(map), Day16::cellSteps(map), Utils::StepIndexer{map});
+
+  const auto distance = [](const auto& paths, const Utils::Step& step) {
+    return paths.reached(step) ? paths.distance(step) : -1;
+  };
+  for (const auto position : map.coordinates()) {
+    if (!corridors.junction(position)) continue;
+    for (const auto direction : Utils::Directions::orthogonal()) {
+      const auto step = Utils::Step{position, direction};
+      EXPECT_EQ(distance(contracted, step), distance(cells, step));
+    }
+  }
+
+  const auto finish      = Day16::closestFinish(map, cells);
+  const auto by_cell     = Utils::CoordinateSet{
+      std::from_range, cells.onShortestPaths(std::array{finish}) |
+                           std::views::transform(&Utils::Step::position)};
+  const auto by_corridor = Utils::CoordinateSet{
+      std::from_range, corridors.cellsOnShortestPaths(
+                           contracted, std::array{finish}, Day16::TURN_COST)};
+  EXPECT_EQ(by_cell.count(), 64);
+  EXPECT_EQ(by_corridor.count(), 64);
+  EXPECT_EQ((by_cell & by_corridor).count(), 64);
+}
+
+// Turns weigh 1000, so the bucket queue wraps around its 1001 buckets many
+// times on the way to the finish; every queue settles the same distances
+TEST(Day_16_Reindeer_Maze_queues_SAMPLE) {
+  using BinaryHeap = Utils::BinaryHeapQueue<int, Utils::Step>;
+  using Buckets    = Utils::BucketQueue<int, Utils::Step, Day16::TURN_COST>;
+  using Radix      = Utils::RadixHeap<int, Utils::Step>;
+
+  const auto map   = Day16::loadMap("16/sample.txt");
+  const auto start = Day16::startEdge(map);
+  const auto steps = Day16::cellSteps(map);
+  const auto index = Utils::StepIndexer{map};
+
+  const auto heap    =
+      Utils::dijkstra<int, Utils::Step, BinaryHeap>(start, steps, index);
+  const auto buckets =
+      Utils::dijkstra<int, Utils::Step, Buckets>(start, steps, index);
+  const auto radix   =
+      Utils::dijkstra<int, Utils::Step, Radix>(start, steps, index);
+  EXPECT_EQ(heap.distance(Day16::closestFinish(map, heap)), 11'048);
+  for (auto idx = size_t{}; idx < index.size(); ++idx) {
+    EXPECT_EQ(buckets.distanceAt(idx), heap.distanceAt(idx));
+    EXPECT_EQ(radix.distanceAt(idx), heap.distanceAt(idx));
+  }
+}
+
+TEST(Day_16_Reindeer_Maze_delta_stepping_SAMPLE) {
+  const auto map       = Day16::loadMap("16/sample.txt");
+  const auto corridors = Day16::corridorsOf(map);
+  const auto paths     = Day16::findPath(map, corridors);
+  for (const auto threads : {size_t{0}, size_t{1}, size_t{4}}) {
+    const auto parallel = Utils::deltaStepping(
+        Day16::startEdge(map), corridors.steps(Day16::TURN_COST),
+        corridors.stepIndexer(), 1, threads);
+    for (auto idx = size_t{}; idx < corridors.stepIndexer().size(); ++idx)
+      EXPECT_EQ(parallel.distanceAt(idx), paths.distanceAt(idx));
+  }
+}
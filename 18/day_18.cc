@@ -3,49 +3,118 @@
 // https://adventofcode.com/2024/day/18
 //
 
+#include <algorithm>
+#include <array>
 #include <filesystem>
 #include <ranges>
 
 #include "testrunner/testrunner.h"
+#include "utils/bit_grid.hh"
+#include "utils/bit_grid_bfs.hh"
 #include "utils/coordinate.hh"
 #include "utils/coordinate_directions.hh"
-#include "utils/coordinate_map.hh"  // IWYU pragma: keep
+#include "utils/coordinate_indexer.hh"
 #include "utils/dijkstras.hh"
 #include "utils/grid.hh"
+#include "utils/grid_graph.hh"
 #include "utils/read_file.hh"
 #include "utils/split.hh"
+#include "utils/weighted_edge.hh"
 
 namespace Day18 {
 
-using Chunks = std::vector<Utils::Coordinate>;
-using Edge   = Utils::WeightedEdge<int, Utils::Coordinate>;
-using Grid   = Utils::Grid<char, Utils::OutOfBoundsPolicy::Default<'#'>>;
+using Chunks    = std::vector<Utils::Coordinate>;
+using FallTimes = Utils::Grid<size_t>;
+using FallGraph = Utils::GridGraph<size_t>;
+using Edge      = Utils::WeightedEdge<int, Utils::Coordinate>;
 
 struct Map {
   Chunks chunks;
   size_t width;
 };
 
-[[nodiscard]] auto findEscapeLength(const Map& map,
-                                    Chunks::const_iterator search_from) -> int {
-  auto grid = Grid{map.width, map.width};
-  std::for_each(map.chunks.cbegin(), search_from,
-                [&](const auto& coordinate) { grid[coordinate] = '#'; });
-
-  const auto start      = Utils::Coordinate(0, 0);
-  const auto start_edge = Edge{0, start};
-  const auto target     = Utils::Coordinate{static_cast<int>(grid.width()) - 1,
-                                        static_cast<int>(grid.height()) - 1};
-
-  const auto adjacent = [&](const auto& from) {
-    return Utils::Directions::orthogonal()                                   //
-           | std::views::transform([&](auto dir) { return from + dir; })     //
-           | std::views::filter([&](auto pos) { return grid[pos] != '#'; })  //
-           | std::views::transform([](auto pos) { return Edge{1, pos}; })    //
-           | std::ranges::to<std::vector>();
+// When each cell is corrupted (the index of its chunk), or chunks.size()
+[[nodiscard]] auto fallTimes(const Map& map) -> FallTimes {
+  auto fall_times = FallTimes{map.width, map.width};
+  fall_times.fill(map.chunks.size());
+  for (auto chunk = map.chunks.size(); chunk-- != 0;)
+    fall_times[map.chunks[chunk]] = chunk;
+  return fall_times;
+}
+
+[[nodiscard]] auto exitOf(const FallTimes& fall_times) -> Utils::Coordinate {
+  return {static_cast<int>(fall_times.width()) - 1,
+          static_cast<int>(fall_times.height()) - 1};
+}
+
+// Length of the path out once `fallen` chunks are down, or 0 if trapped
+[[nodiscard]] auto findEscapeLength(const FallTimes& fall_times,
+                                    size_t fallen) -> int {
+  const auto start = Utils::Coordinate(0, 0);
+  const auto open  = Utils::BitGrid::from(
+      fall_times, [&](size_t fall_time) { return fall_time >= fallen; });
+  auto search = Utils::BitGridBfs{open, std::array{start}};
+  return static_cast<int>(search.distanceTo(exitOf(fall_times)).value_or(0));
+}
+
+// The moves between cells still open once `fallen` chunks are down, for the
+// weighted searches
+[[nodiscard]] auto openMoves(const FallTimes& fall_times, size_t fallen) {
+  return [&fall_times, fallen](const Utils::Coordinate& from, auto&& visit) {
+    for (const auto direction : Utils::Directions::orthogonal()) {
+      const auto to = from + direction;
+      if (fall_times.inBounds(to) and fall_times[to] >= fallen)
+        visit(Edge{1, to});
+    }
   };
+}
 
-  return Utils::dijkstra<int, Utils::Coordinate>(start_edge, target, adjacent);
+// A* over the open cells; heuristic(cell) estimates the moves left to the exit
+[[nodiscard]] auto searchEscape(const FallTimes& fall_times, size_t fallen,
+                                auto&& heuristic) -> Utils::SearchResult<int> {
+  return Utils::aStar<int, Utils::Coordinate>(
+      Edge{0, Utils::Coordinate{0, 0}}, exitOf(fall_times),
+      openMoves(fall_times, fallen), Utils::CoordinateIndexer{fall_times},
+      heuristic);
+}
+
+// Never overestimates the moves left, as no move covers more than one cell
+[[nodiscard]] auto manhattanTo(const Utils::Coordinate& exit) {
+  return [exit](const Utils::Coordinate& at) {
+    return at.manhattanDistanceFrom(exit);
+  };
+}
+
+// The same as findEscapeLength, found by A*. On an open map it heads
+// straight for the exit and settles a fraction of the cells the BFS does.
+[[nodiscard]] auto findEscapeLengthAStar(const FallTimes& fall_times,
+                                         size_t fallen) -> int {
+  return searchEscape(fall_times, fallen, manhattanTo(exitOf(fall_times)))
+      .distance;
+}
+
+// Every move between cells, weighing when the cell it enters is corrupted
+[[nodiscard]] auto fallGraph(const FallTimes& fall_times) -> FallGraph {
+  return FallGraph{fall_times, [](size_t /*unused*/) { return true; },
+                   [&](const Utils::Coordinate& /*unused*/,
+                       const Utils::Coordinate& to) { return fall_times[to]; }};
+}
+
+// The same as findEscapeLength, following the moves of the graph into cells
+// still open
+[[nodiscard]] auto findEscapeLength(const FallGraph& graph, size_t fallen)
+    -> int {
+  const auto open_moves = [&graph, fallen](const Utils::Coordinate& from,
+                                           auto&& visit) {
+    graph(from, [&](const FallGraph::Edge& move) {
+      if (move.distance >= fallen) visit(Edge{1, move.edge});
+    });
+  };
+  const auto exit = graph.indexer().stateAt(graph.size() - 1);  // Last cell
+  return Utils::aStar<int, Utils::Coordinate>(
+             Edge{0, Utils::Coordinate{0, 0}}, exit, open_moves,
+             graph.indexer(), manhattanTo(exit))
+      .distance;
 }
 
 [[nodiscard]] auto readChunks(const std::filesystem::path& path) -> Chunks {
@@ -59,25 +128,27 @@ struct Map {
          | std::ranges::to<std::vector>();
 }
 
-[[nodiscard]] auto escape(
-    const Map& map, Chunks::const_iterator::difference_type escape_at) -> int {
-  return findEscapeLength(map, map.chunks.cbegin() + escape_at);
+[[nodiscard]] auto escape(const Map& map, size_t fallen) -> int {
+  return findEscapeLength(fallTimes(map), fallen);
 }
 
+// The cells only differ in when they fall, so the moves between them are
+// built once and each probe only follows those into cells still open
 [[nodiscard]] auto trapped(const Map& map) -> Utils::Coordinate {
-  auto low  = map.chunks.cbegin();
-  auto high = map.chunks.cend();
+  const auto graph = fallGraph(fallTimes(map));
 
+  auto low  = size_t{};
+  auto high = map.chunks.size();
   while (low < high) {
     const auto mid = low + (high - low) / 2;
-    if (findEscapeLength(map, mid) == 0) {
+    if (findEscapeLength(graph, mid) == 0) {
       high = mid;
     } else {
       low = mid + 1;
     }
   }
 
-  return *std::prev(low);
+  return map.chunks[low - 1];
 }
 
 }  // namespace Day18
@@ -87,3 +158,119 @@ TEST(Day_18_RAM_Run_SAMPLE) {
   EXPECT_EQ(Day18::escape(map, 12), 22);
   EXPECT_EQ(Day18::trapped(map), Utils::Coordinate(6U, 1U));
 }
+
+TEST(Day_18_RAM_Run_fall_graph_SAMPLE) {
+  const auto map        = Day18::Map{Day18::readChunks("18/sample.txt"), 7U};
+  const auto fall_times = Day18::fallTimes(map);
+  const auto graph      = Day18::fallGraph(fall_times);
+  for (const auto fallen : {size_t{12}, size_t{20}, map.chunks.size()}) {
+    EXPECT_EQ(Day18::findEscapeLength(graph, fallen),
+              Day18::findEscapeLength(fall_times, fallen));
+  }
+}
+
+// Moves out of each passable cell, up, right, down then left, to passable
+// cells in the grid
+TEST(Day_18_RAM_Run_grid_graph) {
+  const auto grid     = Utils::Grid<char>::from("..#\n...\n");
+  const auto passable = [](char cell) { return cell == '.'; };
+  const auto weight   = [](const Utils::Coordinate& from,
+                           const Utils::Coordinate& to) {
+    return 10 * (to.y - from.y) + (to.x - from.x);
+  };
+  const auto graph    = Utils::GridGraph<int>{grid, passable, weight};
+  const auto targets  = [&](size_t idx) {
+    return std::vector(graph.targetsAt(idx).begin(),
+                       graph.targetsAt(idx).end());
+  };
+  const auto weights  = [&](size_t idx) {
+    return std::vector(graph.weightsAt(idx).begin(),
+                       graph.weightsAt(idx).end());
+  };
+
+  EXPECT_EQ(graph.size(), 6);
+  EXPECT_TRUE((targets(0) == std::vector<uint32_t>{1, 3}));
+  EXPECT_TRUE((weights(0) == std::vector{1, 10}));
+  EXPECT_TRUE(targets(2).empty());
+  EXPECT_TRUE((targets(4) == std::vector<uint32_t>{1, 5, 3}));
+  EXPECT_TRUE((weights(4) == std::vector{-10, 1, -1}));
+  EXPECT_TRUE((targets(5) == std::vector<uint32_t>{4}));
+
+  auto moves = std::vector<Utils::WeightedEdge<int, Utils::Coordinate>>{};
+  graph(Utils::Coordinate{1, 1}, [&](const auto& move) {
+    moves.push_back(move);
+  });
+  EXPECT_EQ(moves.size(), 3);
+  EXPECT_EQ(moves[1].edge, (Utils::Coordinate{2, 1}));
+  EXPECT_EQ(moves[1].distance, 1);
+
+  // Without a weight every move weighs 1
+  const auto unit = Utils::GridGraph<int>{grid, passable};
+  EXPECT_TRUE((unit.weightsAt(4).size() == 3));
+  EXPECT_TRUE(std::ranges::all_of(unit.weightsAt(4),
+                                  [](int move) { return move == 1; }));
+}
+
+// A* expands no more cells than an unguided search, and strictly fewer on an
+// open grid
+TEST(Day_18_RAM_Run_a_star_SAMPLE) {
+  const auto unguided = [](const Utils::Coordinate& /*unused*/) { return 0; };
+
+  const auto map        = Day18::Map{Day18::readChunks("18/sample.txt"), 7U};
+  const auto fall_times = Day18::fallTimes(map);
+  const auto manhattan  = Day18::manhattanTo(Day18::exitOf(fall_times));
+  for (const auto fallen : {size_t{12}, size_t{20}, map.chunks.size()}) {
+    const auto expected = Day18::findEscapeLength(fall_times, fallen);
+    const auto guided   = Day18::searchEscape(fall_times, fallen, manhattan);
+    const auto plain    = Day18::searchEscape(fall_times, fallen, unguided);
+    EXPECT_EQ(Day18::findEscapeLengthAStar(fall_times, fallen), expected);
+    EXPECT_EQ(guided.distance, expected);
+    EXPECT_EQ(plain.distance, expected);
+    EXPECT_TRUE(guided.expanded <= plain.expanded);
+  }
+
+  // Nothing has fallen (yet) on the full size memory space
+  const auto open   = Day18::FallTimes{71, 71};
+  const auto guided =
+      Day18::searchEscape(open, 0, Day18::manhattanTo(Day18::exitOf(open)));
+  const auto plain  = Day18::searchEscape(open, 0, unguided);
+  EXPECT_EQ(guided.distance, 140);
+  EXPECT_EQ(plain.distance, 140);
+  EXPECT_TRUE(guided.expanded < plain.expanded);
+}
+
+TEST(Day_18_RAM_Run_bidirectional_SAMPLE) {
+  const auto map        = Day18::Map{Day18::readChunks("18/sample.txt"), 7U};
+  const auto fall_times = Day18::fallTimes(map);
+  const auto index      = Utils::CoordinateIndexer{fall_times};
+  const auto start      = Day18::Edge{0, Utils::Coordinate{0, 0}};
+  const auto exit       = Day18::exitOf(fall_times);
+
+  // Moves are symmetric, so the backward search follows them too
+  for (const auto fallen : {size_t{12}, size_t{20}, map.chunks.size()}) {
+    const auto moves   = Day18::openMoves(fall_times, fallen);
+    const auto meeting = Utils::bidirectionalDijkstra<int, Utils::Coordinate>(
+        start, exit, moves, moves, index);
+    EXPECT_EQ(meeting.distance, Day18::findEscapeLength(fall_times, fallen));
+  }
+
+  // The fronts first touch at x = 1, on the road 0-1-4 of length 6; the
+  // search must carry on until it has found 0-2-3-4, of length 5
+  struct Road {
+    int from;
+    int to;
+    int length;
+  };
+  const auto roads = std::array{Road{0, 1, 3}, Road{1, 4, 3}, Road{0, 2, 2},
+                                Road{2, 3, 1}, Road{3, 4, 2}};
+  const auto along = [&](const Utils::Coordinate& at, auto&& visit) {
+    for (const auto& road : roads) {
+      if (road.from == at.x) visit(Day18::Edge{road.length, {road.to, 0}});
+      if (road.to == at.x) visit(Day18::Edge{road.length, {road.from, 0}});
+    }
+  };
+  const auto line    = Utils::CoordinateIndexer{5, 1};
+  const auto meeting = Utils::bidirectionalDijkstra<int, Utils::Coordinate>(
+      start, Utils::Coordinate{4, 0}, along, along, line);
+  EXPECT_EQ(meeting.distance, 5);
+}
@@ -3,10 +3,13 @@
 // https://adventofcode.com/2024/day/19
 //
 
+#include <algorithm>
+#include <array>
 #include <filesystem>
 #include <ranges>
-#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "testrunner/testrunner.h"
@@ -16,18 +19,28 @@
 
 namespace Day19 {
 
-using Towels   = std::vector<std::string>;
-using Patterns = std::vector<std::string>;
+using Towels   = std::vector<std::string_view>;
+using Patterns = std::vector<std::string_view>;
 
-[[nodiscard]] auto loadRules(const std::filesystem::path& path)
-    -> std::pair<Towels, Patterns> {
-  const auto lines = Utils::readLines(path);
-  return std::make_pair(
-      Utils::str_split(lines.front(), ", ") | std::ranges::to<std::vector>(),
-      lines | std::views::drop(2) | std::ranges::to<std::vector>());
+// Towels and patterns point into the mapped input file
+struct Rules {
+  Utils::MappedLines lines;
+  Towels towels;
+  Patterns patterns;
+};
+
+[[nodiscard]] auto loadRules(const std::filesystem::path& path) -> Rules {
+  auto lines    = Utils::readLines(path);
+  auto towels   = lines.front()                 //
+                | Utils::views::split_sv(", ")  //
+                | std::ranges::to<Towels>();
+  auto patterns = lines | std::views::drop(2) | std::ranges::to<Patterns>();
+  return {.lines    = std::move(lines),
+          .towels   = std::move(towels),
+          .patterns = std::move(patterns)};
 }
 
-[[nodiscard]] auto match(auto& cache, const std::string& pattern,
+[[nodiscard]] auto match(auto& cache, std::string_view pattern,
                          const Towels& towels) -> size_t {
   if (pattern.empty()) return 1U;
   if (cache.contains(pattern)) return cache.at(pattern);
@@ -44,7 +57,7 @@ using Patterns = std::vector<std::string>;
 
 [[nodiscard]] auto countDesigns(const Towels& towels, const Patterns& patterns)
     -> std::pair<size_t, size_t> {
-  auto cache       = std::unordered_map<std::string, size_t>{};
+  auto cache       = std::unordered_map<std::string_view, size_t>{};
   const auto count = [&](auto pattern) {
     return match(cache, pattern, towels);
   };
@@ -59,9 +72,16 @@ using Patterns = std::vector<std::string>;
 
 }  // namespace Day19
 
+static_assert(std::ranges::equal(
+    Utils::views::split_sv("r, wr, b", ", "),
+    std::array<std::string_view, 3>{"r", "wr", "b"}));
+static_assert(std::ranges::equal(Utils::views::split_sv("r, wr", ""),
+                                 std::array<std::string_view, 1>{"r, wr"}));
+
 TEST(Day_19_Linen_Layout_SAMPLE) {
-  const auto [towels, patterns] = Day19::loadRules("19/sample.txt");
-  const auto [unique, total]    = Day19::countDesigns(towels, patterns);
+  const auto rules           = Day19::loadRules("19/sample.txt");
+  const auto [unique, total] =
+      Day19::countDesigns(rules.towels, rules.patterns);
   EXPECT_EQ(unique, 6);
   EXPECT_EQ(total, 16);
 }
@@ -5,68 +5,50 @@
 
 #include <fmt/core.h>
 
+#include <array>
 #include <filesystem>
 #include <fstream>
-#include <ranges>
 
 #include "testrunner/testrunner.h"
+#include "utils/bfs.hh"
 #include "utils/coordinate.hh"
-#include "utils/coordinate_directions.hh"
-#include "utils/coordinate_map.hh"  // IWYU pragma: keep
-#include "utils/dijkstras.hh"
 #include "utils/grid.hh"
 #include "utils/nm_view.hh"
 
 namespace Day20 {
 
-using Map  = Utils::Grid<char, Utils::OutOfBoundsPolicy::Default<'#'>>;
-using Edge = Utils::WeightedEdge<int, Utils::Coordinate>;
-
-using Route       = std::vector<Utils::Coordinate>;
-using DistanceMap = std::array<int, 256ULL * 256>;
-
-[[nodiscard]] constexpr auto at(Utils::Coordinate coordinate) -> size_t {
-  return static_cast<size_t>(coordinate.y) * 256ULL +
-         static_cast<size_t>(coordinate.x);
-}
+using Map       = Utils::Grid<char, Utils::OutOfBoundsPolicy::Halo<'#'>>;
+using Route     = std::vector<Utils::Coordinate>;
+using Distances = Utils::Grid<int>;
 
 [[nodiscard]] auto loadMap(const std::filesystem::path& path) -> Map {
   auto file = std::ifstream(path);
   return Map::from(file);
 }
 
-[[nodiscard]] auto findPath(const Map& map) -> std::pair<DistanceMap, Route> {
-  const auto end = map.find('E').value_or(Utils::Coordinate{});
-
-  const auto adjacent = [&](const auto& from) {
-    return Utils::Directions::orthogonal()                                  //
-           | std::views::transform([&](auto dir) { return from + dir; })    //
-           | std::views::filter([&](auto pos) { return map[pos] != '#'; })  //
-           | std::views::transform([](auto pos) { return Edge{1, pos}; })   //
-           | std::ranges::to<std::vector>();
-  };
+// The route from S to E, empty if E cannot be reached
+[[nodiscard]] auto findPath(const Map& map) -> std::pair<Distances, Route> {
+  const auto end  = map.find('E').value_or(Utils::Coordinate{});
+  const auto open = [](char tile) { return tile != '#'; };
 
-  const auto& [distances, previous] = Utils::dijkstra(Edge{0, end}, adjacent);
-
-  auto distance_map = DistanceMap{};
-  for (const auto [coordinate, distance] : distances)
-    distance_map[at(coordinate)] = distance;
-  distance_map[at(end)] = 0;
+  auto [distances, parents] = Utils::bfsTree(map, std::array{end}, open);
 
   auto route    = Route{};
   auto position = map.find('S').value_or(Utils::Coordinate{});
+  if (distances[position] == -1)
+    return std::make_pair(std::move(distances), route);
   while (true) {
     route.push_back(position);
     if (position == end) break;
-    position = *previous.at(position).begin();
+    position -= parents[position];
   }
 
-  return std::make_pair(distance_map, route);
+  return std::make_pair(std::move(distances), route);
 }
 
 [[nodiscard]] auto findCheats(const Map& map,
                               int save_at_least) -> std::pair<size_t, size_t> {
-  const auto [distance_map, route] = findPath(map);
+  const auto [distances, route] = findPath(map);
 
   auto old_rules = int{};
   auto new_rules = int{};
@@ -74,8 +56,8 @@ using DistanceMap = std::array<int, 256ULL * 256>;
   for (const auto [a, b] : Utils::nm_const_view(route)) {
     const auto distance = a->manhattanDistanceFrom(*b);
     if (distance <= 20) {
-      const auto d1 = distance_map[at(*a)];
-      const auto d2 = distance_map[at(*b)];
+      const auto d1 = distances[*a];
+      const auto d2 = distances[*b];
       if (d1 > d2                   //
           and (d1 - d2) > distance  //
           and (d1 - d2 - distance) >= save_at_least) {
@@ -95,3 +77,25 @@ TEST(Day_20_Race_Condition_SAMPLE) {
   const auto [_, new_rules] = Day20::findCheats(map, 50U);
   EXPECT_EQ(new_rules, 285U);
 }
+
+TEST(Day_20_Race_Condition_walled_off) {
+  const auto map                    = Day20::Map::from("S#E\n");
+  const auto [_, route]             = Day20::findPath(map);
+  const auto [old_rules, new_rules] = Day20::findCheats(map, 0);
+  EXPECT_EQ(route.size(), 0U);
+  EXPECT_EQ(old_rules, 0U);
+  EXPECT_EQ(new_rules, 0U);
+
+  // A search from the wall itself reaches nothing
+  const auto open      = [](char tile) { return tile != '#'; };
+  const auto wall      = Utils::Coordinate{1, 0};
+  const auto from_wall = Utils::bfs(map, std::array{wall}, open);
+  EXPECT_EQ(from_wall[wall], -1);
+  EXPECT_EQ(from_wall[map.find('S').value_or(wall)], -1);
+
+  // A search that may cross walls still stays on the grid
+  const auto anything = [](char /*unused*/) { return true; };
+  const auto through  = Utils::bfs(map, std::array{wall}, anything);
+  EXPECT_EQ(through[map.find('S').value_or(wall)], 1);
+  EXPECT_EQ(through[map.find('E').value_or(wall)], 1);
+}
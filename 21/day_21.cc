@@ -33,7 +33,7 @@ struct hash<std::array<char, 2>> {
 
 namespace Day21 {
 
-using Keypad = Utils::Grid<char, Utils::OutOfBoundsPolicy::Default<' '>>;
+using Keypad = Utils::Grid<char, Utils::OutOfBoundsPolicy::Halo<' '>>;
 using Paths = std::unordered_map<std::array<char, 2>, std::vector<std::string>>;
 
 [[nodiscard]] auto pathsForKeypad(const Keypad& keypad) -> Paths {
@@ -130,7 +130,7 @@ using Paths = std::unordered_map<std::array<char, 2>, std::vector<std::string>>;
   return length;
 }
 
-[[nodiscard]] auto calculateComplexity(const std::vector<std::string>& codes,
+[[nodiscard]] auto calculateComplexity(const auto& codes,
                                        size_t depth) -> size_t {
   const auto number_pad_paths = pathsForKeypad({3, "789456123 0A"});
   const auto arrow_pad_paths  = pathsForKeypad({3, " ^A<v>"});
@@ -150,7 +150,7 @@ using Paths = std::unordered_map<std::array<char, 2>, std::vector<std::string>>;
 
   auto total = size_t{};
   for (const auto& code : codes) {
-    const auto solutions = solutionsFor(number_pad_paths, code);
+    const auto solutions = solutionsFor(number_pad_paths, std::string{code});
     const auto length =
         std::ranges::min(solutions | std::views::transform(calculate_length));
     total += Utils::from_chars<size_t>(code) * length;
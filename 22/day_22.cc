@@ -10,10 +10,12 @@
 #include <bitset>
 #include <filesystem>
 #include <ranges>
+#include <string>
 #include <vector>
 
 #include "testrunner/testrunner.h"
 #include "utils/charconv.hh"
+#include "utils/line_stream.hh"
 #include "utils/read_file.hh"
 #include "utils/sum.hh"
 
@@ -25,7 +27,7 @@ using CountsArray = std::array<size_t, 160'000>;
 
 [[nodiscard]] auto readSeeds(const std::filesystem::path& path)
     -> std::vector<int64_t> {
-  return Utils::readLines(path) |
+  return Utils::LineStream{path} |
          std::views::transform(Utils::from_chars<int64_t>) |
          std::ranges::to<std::vector>();
 }
@@ -95,3 +97,25 @@ TEST(Day_22_Monkey_Market_SAMPLE) {
   const auto seeds_sample2 = Day22::readSeeds("22/sample2.txt");
   EXPECT_EQ(Day22::sequenceBuyers(seeds_sample2), 23);
 }
+
+// Lines cut off at a chunk boundary, lines longer than a chunk and a last
+// line without its newline come out as readLines() sees them
+TEST(Day_22_Monkey_Market_line_stream) {
+  for (const auto* path : {"22/sample.txt", "22/sample_unterminated.txt"}) {
+    const auto expected = Utils::readLines(path);
+    const auto contents = Utils::readFile(path);
+    for (const auto chunk_size : {size_t{1}, size_t{3}, size_t{7}}) {
+      auto lines = size_t{};
+      for (const auto line : Utils::LineStream{path, chunk_size}) {
+        EXPECT_EQ(line, expected[std::min(lines, expected.size() - 1)]);
+        ++lines;
+      }
+      EXPECT_EQ(lines, expected.size());
+
+      auto stream = Utils::LineStream{path, chunk_size};
+      auto joined = std::string{};
+      while (const auto block = stream.nextLines()) joined += *block;
+      EXPECT_EQ(joined, contents.view());
+    }
+  }
+}
@@ -0,0 +1,97 @@
+#ifndef BENCH_BENCH_HH
+#define BENCH_BENCH_HH
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "utils/coordinate_directions.hh"
+#include "utils/coordinate_step.hh"
+#include "utils/weighted_edge.hh"
+
+namespace Bench {
+
+// Keeps a result alive so the work producing it is not optimised away
+template <typename T>
+void keep(const T& value) {
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+// Best wall time of a number of runs, in microseconds. The best run is the
+// one least disturbed by the rest of the machine.
+template <typename FUNCTION>
+[[nodiscard]] auto bestOf(int runs, FUNCTION&& function) -> double {
+  using Micros = std::chrono::duration<double, std::micro>;
+  auto best    = Micros::max();
+  for (int run = 0; run != runs; ++run) {
+    const auto start = std::chrono::steady_clock::now();
+    keep(function());
+    best = std::min(best, Micros{std::chrono::steady_clock::now() - start});
+  }
+  return best.count();
+}
+
+inline void report(std::string_view what, double baseline, double measured) {
+  fmt::print("{:<44} {:>11.1f}us {:>11.1f}us {:>6.2f}x\n", what, baseline,
+             measured, baseline / measured);
+}
+
+// Counts (of allocations, say) in the same columns as report
+inline void reportCount(std::string_view what, size_t baseline,
+                        size_t measured) {
+  fmt::print("{:<44} {:>13} {:>13}\n", what, baseline, measured);
+}
+
+// Day 16's per-cell model: step forward, or turn towards an open cell. Edges
+// are offered in the same order whatever the maze's layout.
+inline constexpr auto TURN_COST = 1000;
+
+template <typename MAZE>
+void reindeerSteps(const MAZE& maze, const Utils::Step& from, auto&& visit) {
+  using Edge = Utils::WeightedEdge<int, Utils::Step>;
+  if (maze[from.next()] != '#')
+    visit(Edge{1, Utils::Step{from.next(), from.direction}});
+  for (const auto turned : {Utils::rotatedCounterClockwise(from.direction),
+                            Utils::rotatedClockwise(from.direction)}) {
+    const auto to = Utils::Step{from.position, turned};
+    if (maze[to.next()] != '#') visit(Edge{TURN_COST, to});
+  }
+}
+
+// Deterministic stand-in for puzzle input
+class Random {
+  uint64_t state_;
+
+ public:
+  constexpr explicit Random(uint64_t seed) : state_{seed} {}
+
+  constexpr auto operator()(uint64_t bound) -> uint64_t {
+    state_ ^= state_ << 13;
+    state_ ^= state_ >> 7;
+    state_ ^= state_ << 17;
+    return state_ % bound;
+  }
+};
+
+// A width x height maze of '.' and '#', a wall density out of 100
+[[nodiscard]] inline auto mazeText(size_t width, size_t height,
+                                   uint64_t density, uint64_t seed = 1)
+    -> std::string {
+  auto random = Random{seed};
+  auto text   = std::string{};
+  text.reserve((width + 1) * height);
+  for (size_t y = 0; y != height; ++y) {
+    for (size_t x = 0; x != width; ++x)
+      text.push_back(random(100) < density ? '#' : '.');
+    text.push_back('\n');
+  }
+  return text;
+}
+
+}  // namespace Bench
+
+#endif  // BENCH_BENCH_HH
@@ -0,0 +1,135 @@
+//
+// int2str's Advent of Code 2024
+// Adjacency shapes: a vector per expansion, an InplaceVector, and a visitor
+//
+
+#include <fmt/core.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "testrunner/testrunner.h"
+#include "utils/coordinate.hh"
+#include "utils/coordinate_directions.hh"
+#include "utils/coordinate_step.hh"
+#include "utils/coordinate_step_indexer.hh"
+#include "utils/dijkstras.hh"
+#include "utils/grid.hh"
+#include "utils/inplace_vector.hh"
+#include "utils/weighted_edge.hh"
+
+namespace {
+
+std::atomic<size_t> allocation_count{};
+
+}  // namespace
+
+// Replaces the global allocation functions of the whole bench binary, so
+// that the allocations a search makes can be counted
+auto operator new(size_t size) -> void* {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (auto* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory, size_t /*unused*/) noexcept {
+  std::free(memory);
+}
+
+namespace {
+
+using Maze = Utils::Grid<char>;
+using Edge = Utils::WeightedEdge<int, Utils::Step>;
+
+TEST(Bench_Adjacency) {
+  for (const auto side : {size_t{128}, size_t{512}}) {
+    // Walled in all round, so no step leaves the maze, with the start cleared
+    // around so that it is not walled in
+    auto maze = Maze::from(Bench::mazeText(side, side, 25));
+    for (size_t i = 0; i != side; ++i) {
+      maze[i, 0] = maze[i, side - 1] = '#';
+      maze[0, i] = maze[side - 1, i] = '#';
+    }
+    const auto middle = static_cast<int>(side / 2);
+    const auto start  = Edge{0, Utils::Step{Utils::Coordinate{middle, middle},
+                                           Utils::Coordinate{1, 0}}};
+    for (int y = -2; y != 3; ++y)
+      for (int x = -2; x != 3; ++x)
+        maze[start.edge.position + Utils::Coordinate{x, y}] = '.';
+    const auto index = Utils::StepIndexer{maze};
+
+    const auto vectors = [&](const Utils::Step& from) {
+      auto edges = std::vector<Edge>{};
+      Bench::reindeerSteps(maze, from,
+                           [&](const Edge& edge) { edges.push_back(edge); });
+      return edges;
+    };
+    const auto inplace = [&](const Utils::Step& from) {
+      auto edges = Utils::InplaceVector<Edge, 3>{};
+      Bench::reindeerSteps(maze, from,
+                           [&](const Edge& edge) { edges.push_back(edge); });
+      return edges;
+    };
+    const auto visitor = [&](const Utils::Step& from, auto&& visit) {
+      Bench::reindeerSteps(maze, from, visit);
+    };
+
+    // Every state the search settled; the shapes must agree on all of them
+    const auto reachedIn = [&](const auto& paths) {
+      auto reached = 0;
+      for (size_t y = 0; y != side; ++y)
+        for (size_t x = 0; x != side; ++x)
+          for (const auto direction : Utils::Directions::orthogonal()) {
+            const auto position =
+                Utils::Coordinate{static_cast<int>(x), static_cast<int>(y)};
+            if (paths.reached(Utils::Step{position, direction})) ++reached;
+          }
+      return reached;
+    };
+    const auto search = [&](const auto& adjacency) {
+      return Utils::dijkstra<int, Utils::Step>(start, adjacency, index);
+    };
+
+    const auto allocationsIn = [&](const auto& adjacency) {
+      const auto before = allocation_count.load();
+      Bench::keep(search(adjacency));
+      return allocation_count.load() - before;
+    };
+
+    const auto reached = reachedIn(search(vectors));
+    EXPECT_EQ(reachedIn(search(inplace)), reached);
+    EXPECT_EQ(reachedIn(search(visitor)), reached);
+
+    // Neither the InplaceVector nor the visitor allocates, which leaves the
+    // distances, the predecessor DAG and the queue's buckets, which do not
+    // grow with every state
+    const auto vector_allocations  = allocationsIn(vectors);
+    const auto inplace_allocations = allocationsIn(inplace);
+    const auto visitor_allocations = allocationsIn(visitor);
+    EXPECT_EQ(inplace_allocations, visitor_allocations);
+    EXPECT_TRUE(visitor_allocations * 100 < static_cast<size_t>(reached));
+    EXPECT_TRUE(vector_allocations > static_cast<size_t>(reached));
+
+    const auto with_vectors = Bench::bestOf(5, [&] { return search(vectors); });
+    const auto with_inplace = Bench::bestOf(5, [&] { return search(inplace); });
+    const auto with_visitor = Bench::bestOf(5, [&] { return search(visitor); });
+
+    const auto what = fmt::format("{0}x{0} maze, {1} states", side,
+                                  reached);
+    Bench::report(what + ", InplaceVector", with_vectors, with_inplace);
+    Bench::report(what + ", visitor", with_vectors, with_visitor);
+    const auto counted = fmt::format("{0}x{0} maze, allocations", side);
+    Bench::reportCount(counted + ", InplaceVector", vector_allocations,
+                       inplace_allocations);
+    Bench::reportCount(counted + ", visitor", vector_allocations,
+                       visitor_allocations);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,67 @@
+//
+// int2str's Advent of Code 2024
+// Unit weight searches: BitGridBfs against the queue based Utils::bfs
+//
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "bench/bench.hh"
+#include "testrunner/testrunner.h"
+#include "utils/bfs.hh"
+#include "utils/bit_grid.hh"
+#include "utils/bit_grid_bfs.hh"
+#include "utils/coordinate.hh"
+#include "utils/grid.hh"
+
+namespace {
+
+using Maze = Utils::Grid<char>;
+
+TEST(Bench_BitGridBfs) {
+  for (const auto side : {size_t{128}, size_t{512}, size_t{2048}}) {
+    // From the middle of the maze, cleared around so that it is not walled in
+    auto maze         = Maze::from(Bench::mazeText(side, side, 25));
+    const auto middle = static_cast<int>(side / 2);
+    const auto source = Utils::Coordinate{middle, middle};
+    for (int y = -2; y != 3; ++y)
+      for (int x = -2; x != 3; ++x)
+        maze[source + Utils::Coordinate{x, y}] = '.';
+
+    const auto passable = [](char tile) { return tile != '#'; };
+    const auto open     = Utils::BitGrid::from(maze, passable);
+
+    const auto queued = Utils::bfs(maze, std::array{source}, passable);
+    auto search       = Utils::BitGridBfs{open, std::array{source}};
+    search.run();
+
+    // Both reach the same cells, as far
+    auto reached  = size_t{};
+    auto furthest = size_t{};
+    for (const auto cell : maze.coordinates())
+      if (queued[cell] != -1) {
+        ++reached;
+        furthest = std::max(furthest, static_cast<size_t>(queued[cell]));
+      }
+    EXPECT_EQ(search.visited().count(), reached);
+    EXPECT_EQ(search.layer(), furthest);
+
+    const auto with_queue = Bench::bestOf(5, [&] {
+      return Utils::bfs(maze, std::array{source}, passable);
+    });
+    const auto with_bits = Bench::bestOf(5, [&] {
+      auto bfs = Utils::BitGridBfs{open, std::array{source}};
+      bfs.run();
+      return bfs.layer();
+    });
+
+    Bench::report(fmt::format("{0}x{0} maze, {1} cells, {2} layers", side,
+                              reached, furthest),
+                  with_queue, with_bits);
+  }
+}
+
+}  // namespace
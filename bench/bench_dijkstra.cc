@@ -0,0 +1,66 @@
+//
+// int2str's Advent of Code 2024
+// Point to point searches: bidirectional dijkstra against a forward search
+//
+
+#include <cstddef>
+
+#include "bench/bench.hh"
+#include "testrunner/testrunner.h"
+#include "utils/coordinate.hh"
+#include "utils/coordinate_directions.hh"
+#include "utils/coordinate_indexer.hh"
+#include "utils/dijkstras.hh"
+#include "utils/grid.hh"
+#include "utils/weighted_edge.hh"
+
+namespace {
+
+using Maze = Utils::Grid<char>;
+using Edge = Utils::WeightedEdge<int, Utils::Coordinate>;
+
+TEST(Bench_BidirectionalDijkstra) {
+  for (const auto side : {size_t{128}, size_t{512}, size_t{1024}}) {
+    // Between two points well inside the maze, cleared around so that neither
+    // is walled in
+    auto maze         = Maze::from(Bench::mazeText(side, side, 25));
+    const auto middle = static_cast<int>(side / 2);
+    const auto start  = Utils::Coordinate{middle / 2, middle};
+    const auto finish = Utils::Coordinate{middle + (middle / 2), middle};
+    for (int y = -2; y != 3; ++y)
+      for (int x = -2; x != 3; ++x) {
+        maze[start + Utils::Coordinate{x, y}]  = '.';
+        maze[finish + Utils::Coordinate{x, y}] = '.';
+      }
+
+    const auto moves = [&](const Utils::Coordinate& from, auto&& visit) {
+      for (const auto direction : Utils::Directions::orthogonal()) {
+        const auto to = from + direction;
+        if (maze.inBounds(to) and maze[to] != '#') visit(Edge{1, to});
+      }
+    };
+    const auto index = Utils::CoordinateIndexer{maze};
+    const auto none  = [](const Utils::Coordinate& /*unused*/) { return 0; };
+
+    auto forward       = Utils::SearchResult<int>{};
+    const auto one_way = Bench::bestOf(5, [&] {
+      forward = Utils::aStar<int, Utils::Coordinate>(Edge{0, start}, finish,
+                                                     moves, index, none);
+      return forward.distance;
+    });
+
+    auto meeting       = Utils::SearchResult<int>{};
+    const auto two_way = Bench::bestOf(5, [&] {
+      meeting = Utils::bidirectionalDijkstra<int, Utils::Coordinate>(
+          Edge{0, start}, finish, moves, moves, index);
+      return meeting.distance;
+    });
+
+    EXPECT_EQ(meeting.distance, forward.distance);
+    Bench::report(fmt::format("{0}x{0} maze, {1} vs {2} expanded", side,
+                              forward.expanded, meeting.expanded),
+                  one_way, two_way);
+  }
+}
+
+}  // namespace
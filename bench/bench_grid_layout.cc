@@ -0,0 +1,130 @@
+//
+// int2str's Advent of Code 2024
+// Grid storage layouts: a BFS tree and Day 16's search over row-major, tiled
+// and Morton grids
+//
+
+#include <fmt/core.h>
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "bench/bench.hh"
+#include "testrunner/testrunner.h"
+#include "utils/bfs.hh"
+#include "utils/coordinate.hh"
+#include "utils/coordinate_step.hh"
+#include "utils/coordinate_step_indexer.hh"
+#include "utils/dijkstras.hh"
+#include "utils/grid.hh"
+#include "utils/weighted_edge.hh"
+
+namespace {
+
+template <typename LAYOUT>
+using Maze = Utils::Grid<char, Utils::OutOfBoundsPolicy::Halo<'#'>, LAYOUT>;
+
+// The maze with its middle cleared around, so that a search from there is not
+// walled in
+template <typename LAYOUT>
+auto mazeFrom(const std::string& text, size_t side)
+    -> std::pair<Maze<LAYOUT>, Utils::Coordinate> {
+  auto maze         = Maze<LAYOUT>::from(text);
+  const auto middle = static_cast<int>(side / 2);
+  const auto source = Utils::Coordinate{middle, middle};
+  for (int y = -2; y != 3; ++y)
+    for (int x = -2; x != 3; ++x)
+      maze[source + Utils::Coordinate{x, y}] = '.';
+  return {std::move(maze), source};
+}
+
+// A full search from the middle of the maze, as for Day 20. Returns how many
+// cells it reached along with its best time.
+template <typename LAYOUT>
+auto timeBfsTree(const std::string& text, size_t side)
+    -> std::pair<size_t, double> {
+  const auto [maze, source] = mazeFrom<LAYOUT>(text, side);
+
+  const auto open = [](char tile) { return tile != '#'; };
+  const auto tree = Utils::bfsTree(maze, std::array{source}, open);
+  auto reached    = size_t{};
+  for (const auto cell : maze.coordinates())
+    if (tree.distances[cell] != -1) ++reached;
+
+  const auto best = Bench::bestOf(5, [&] {
+    return Utils::bfsTree(maze, std::array{source}, open);
+  });
+  return {reached, best};
+}
+
+// Day 16's per-cell dijkstra from the middle of the maze, reading the maze
+// through the layout on every expansion (its own bookkeeping is row-major
+// whatever the layout). Returns how many states it reached along with its
+// best time.
+template <typename LAYOUT>
+auto timeReindeerMaze(const std::string& text, size_t side)
+    -> std::pair<size_t, double> {
+  const auto [maze, source] = mazeFrom<LAYOUT>(text, side);
+
+  const auto start = Utils::WeightedEdge<int, Utils::Step>{
+      0, Utils::Step{source, Utils::Coordinate{1, 0}}};
+  const auto steps = [&](const Utils::Step& from, auto&& visit) {
+    Bench::reindeerSteps(maze, from, visit);
+  };
+  const auto index = Utils::StepIndexer{maze};
+  const auto paths = Utils::dijkstra<int, Utils::Step>(start, steps, index);
+  auto reached     = size_t{};
+  for (auto idx = size_t{}; idx != index.size(); ++idx)
+    if (paths.distanceAt(idx) != std::numeric_limits<int>::max()) ++reached;
+
+  const auto best = Bench::bestOf(5, [&] {
+    return Utils::dijkstra<int, Utils::Step>(start, steps, index);
+  });
+  return {reached, best};
+}
+
+TEST(Bench_GridLayout) {
+  // Without BMI2 in the build, Morton offsets take the portable fallback
+  fmt::print("Morton offsets by {}\n", Utils::Layout::Morton::uses_pdep
+                                           ? "pdep"
+                                           : "shifts and masks (no -mbmi2)");
+
+  for (const auto side : {size_t{141}, size_t{1024}, size_t{2048}}) {
+    const auto text = Bench::mazeText(side, side, 28);
+
+    const auto [reached, row_major] =
+        timeBfsTree<Utils::Layout::RowMajor>(text, side);
+    const auto report = [&](std::string_view layout, auto measured) {
+      EXPECT_EQ(measured.first, reached);
+      Bench::report(fmt::format("{0}x{0} bfsTree, {1} cells, {2}", side,
+                                reached, layout),
+                    row_major, measured.second);
+    };
+    report("tiled 8", timeBfsTree<Utils::Layout::Tiled<8>>(text, side));
+    report("tiled 16", timeBfsTree<Utils::Layout::Tiled<16>>(text, side));
+    report("Morton", timeBfsTree<Utils::Layout::Morton>(text, side));
+  }
+
+  // 141x141 is the size of the puzzle's own maze
+  for (const auto side : {size_t{141}, size_t{1024}}) {
+    const auto text = Bench::mazeText(side, side, 28);
+
+    const auto [reached, row_major] =
+        timeReindeerMaze<Utils::Layout::RowMajor>(text, side);
+    const auto report = [&](std::string_view layout, auto measured) {
+      EXPECT_EQ(measured.first, reached);
+      Bench::report(fmt::format("{0}x{0} Day 16, {1} states, {2}", side,
+                                reached, layout),
+                    row_major, measured.second);
+    };
+    report("tiled 8", timeReindeerMaze<Utils::Layout::Tiled<8>>(text, side));
+    report("tiled 16", timeReindeerMaze<Utils::Layout::Tiled<16>>(text, side));
+    report("Morton", timeReindeerMaze<Utils::Layout::Morton>(text, side));
+  }
+}
+
+}  // namespace
@@ -0,0 +1,43 @@
+//
+// int2str's Advent of Code 2024
+// Line splitting: LineIndex against std::getline
+//
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+#include "bench/bench.hh"
+#include "testrunner/testrunner.h"
+#include "utils/line_index.hh"
+
+namespace {
+
+TEST(Bench_LineIndex) {
+  for (const auto width : {size_t{8}, size_t{80}, size_t{400}}) {
+    const auto text = Bench::mazeText(width, (size_t{16} << 20) / width, 30);
+
+    auto getline_total = size_t{};
+    const auto getline = Bench::bestOf(5, [&] {
+      auto input = std::istringstream{text};
+      auto line  = std::string{};
+      auto total = size_t{};
+      while (std::getline(input, line)) total += line.size();
+      getline_total = total;
+      return total;
+    });
+
+    auto index_total = size_t{};
+    const auto index = Bench::bestOf(5, [&] {
+      auto total = size_t{};
+      for (const auto line : Utils::LineIndex{text}) total += line.size();
+      index_total = total;
+      return total;
+    });
+
+    EXPECT_EQ(index_total, getline_total);
+    Bench::report(fmt::format("16MB, {} byte lines", width), getline, index);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,93 @@
+//
+// int2str's Advent of Code 2024
+// Integer records: parseIntegers against a line at a time from_chars parse
+//
+
+#include <charconv>
+#include <cstdint>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "testrunner/testrunner.h"
+#include "utils/parse_integers.hh"
+
+namespace {
+
+// Day 1: two columns of five digit numbers
+[[nodiscard]] auto listsText(size_t lines) -> std::string {
+  auto random = Bench::Random{1};
+  auto text   = std::string{};
+  for (size_t line = 0; line != lines; ++line)
+    text += fmt::format("{}   {}\n", 10000 + random(90000),
+                        10000 + random(90000));
+  return text;
+}
+
+// Day 7: a large target and a handful of small operands
+[[nodiscard]] auto equationsText(size_t lines) -> std::string {
+  auto random = Bench::Random{7};
+  auto text   = std::string{};
+  for (size_t line = 0; line != lines; ++line) {
+    text += fmt::format("{}:", random(uint64_t{1} << 40));
+    for (auto operands = 3 + random(8); operands != 0; --operands)
+      text += fmt::format(" {}", 1 + random(999));
+    text += '\n';
+  }
+  return text;
+}
+
+[[nodiscard]] auto lineAtATime(const std::string& text)
+    -> std::vector<uint64_t> {
+  auto values = std::vector<uint64_t>{};
+  auto input  = std::istringstream{text};
+  auto line   = std::string{};
+  while (std::getline(input, line)) {
+    const auto* const end = line.data() + line.size();
+    for (const auto* pos = line.data(); pos != end;) {
+      auto value = uint64_t{};
+      if (const auto [next, error] = std::from_chars(pos, end, value);
+          error == std::errc{}) {
+        values.push_back(value);
+        pos = next;
+      } else {
+        ++pos;
+      }
+    }
+  }
+  return values;
+}
+
+void compare(std::string_view what, const std::string& text) {
+  const auto runs = text.size() < (size_t{1} << 20) ? 500 : 10;
+
+  auto expected       = uint64_t{};
+  const auto baseline = Bench::bestOf(runs, [&] {
+    const auto values = lineAtATime(text);
+    expected          = std::reduce(values.begin(), values.end(), uint64_t{});
+    return values.size();
+  });
+
+  auto parsed      = uint64_t{};
+  const auto batch = Bench::bestOf(runs, [&] {
+    const auto rows = Utils::parseIntegers<uint64_t>(text);
+    parsed          = std::reduce(rows.values().begin(), rows.values().end(),
+                                  uint64_t{});
+    return rows.size();
+  });
+
+  EXPECT_EQ(parsed, expected);
+  Bench::report(fmt::format("{}, {}KB", what, text.size() >> 10), baseline,
+                batch);
+}
+
+TEST(Bench_ParseIntegers) {
+  compare("Day 1 lists", listsText(1000));
+  compare("Day 7 equations", equationsText(850));
+  compare("Day 1 lists", listsText(1 << 20));
+  compare("Day 7 equations", equationsText(1 << 18));
+}
+
+}  // namespace
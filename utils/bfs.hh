@@ -0,0 +1,115 @@
+#ifndef UTILS_BFS_HH
+#define UTILS_BFS_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+#include "coordinate.hh"
+#include "coordinate_directions.hh"
+#include "grid.hh"
+
+namespace Utils {
+
+namespace Detail {
+
+// Calls reached(cell, direction) as each cell is first reached, with the
+// direction of the move onto it. Every cell is queued at most once, so the
+// frontier is a single flat buffer with a read and a write position.
+template <typename STORE_AS, typename OOB_POLICY, typename LAYOUT>
+void breadthFirst(const Grid<STORE_AS, OOB_POLICY, LAYOUT>& grid,
+                  std::ranges::input_range auto&& sources, auto&& passable,
+                  Grid<int, OutOfBoundsPolicy::Undefined, LAYOUT>& distances,
+                  auto&& reached) {
+  const auto width = grid.width();
+  const auto at    = [&](const Coordinate& cell) {
+    return static_cast<size_t>(cell.y) * width + static_cast<size_t>(cell.x);
+  };
+
+  // Moves off a Halo grid land on its frame, so passable() alone turns them
+  // away unless the frame's value is itself passable
+  const auto check_bounds = [&] {
+    if constexpr (requires { OOB_POLICY::border; })
+      return static_cast<bool>(
+          passable(static_cast<STORE_AS>(OOB_POLICY::default_value)));
+    return true;
+  }();
+
+  distances.fill(-1);
+  auto visited  = std::vector<bool>(width * grid.height());
+  auto frontier = std::vector<Coordinate>(width * grid.height());
+  auto head     = size_t{};
+  auto tail     = size_t{};
+
+  for (const auto& source : sources) {
+    if (!grid.inBounds(source) or visited[at(source)] or
+        !passable(grid[source]))
+      continue;
+    visited[at(source)] = true;
+    distances[source]   = 0;
+    frontier[tail++]    = source;
+  }
+
+  while (head != tail) {
+    const auto from     = frontier[head++];
+    const auto distance = distances[from] + 1;
+    for (const auto direction : Directions::orthogonal()) {
+      const auto to = from + direction;
+      if ((check_bounds and !grid.inBounds(to)) or !passable(grid[to]) or
+          visited[at(to)])
+        continue;
+      visited[at(to)] = true;
+      distances[to]   = distance;
+      reached(to, direction);
+      frontier[tail++] = to;
+    }
+  }
+}
+
+}  // namespace Detail
+
+// Breadth first search over the orthogonal moves between the passable cells
+// of a grid (passable is asked of cell values), from any number of sources.
+// Distances are in moves from the nearest source; unreached cells hold -1,
+// as do sources that are not passable themselves.
+// They are stored in the same layout as the grid.
+template <typename STORE_AS, typename OOB_POLICY, typename LAYOUT>
+[[nodiscard]] auto bfs(const Grid<STORE_AS, OOB_POLICY, LAYOUT>& grid,
+                       std::ranges::input_range auto&& sources,
+                       auto&& passable)
+    -> Grid<int, OutOfBoundsPolicy::Undefined, LAYOUT> {
+  auto distances =
+      Grid<int, OutOfBoundsPolicy::Undefined, LAYOUT>{grid.width(),
+                                                      grid.height()};
+  Detail::breadthFirst(grid, sources, passable, distances,
+                       [](const Coordinate& /*unused*/,
+                          const Coordinate& /*unused*/) {});
+  return distances;
+}
+
+// Distances along with the direction of the move onto every reached cell;
+// cell - parents[cell] is one step closer to a source. Sources and unreached
+// cells have no parent, {0, 0}.
+template <typename LAYOUT = Layout::RowMajor>
+struct BfsTree {
+  Grid<int, OutOfBoundsPolicy::Undefined, LAYOUT> distances;
+  Grid<Coordinate, OutOfBoundsPolicy::Undefined, LAYOUT> parents;
+};
+
+template <typename STORE_AS, typename OOB_POLICY, typename LAYOUT>
+[[nodiscard]] auto bfsTree(const Grid<STORE_AS, OOB_POLICY, LAYOUT>& grid,
+                           std::ranges::input_range auto&& sources,
+                           auto&& passable) -> BfsTree<LAYOUT> {
+  auto tree = BfsTree<LAYOUT>{.distances = {grid.width(), grid.height()},
+                              .parents   = {grid.width(), grid.height()}};
+  Detail::breadthFirst(grid, sources, passable, tree.distances,
+                       [&](const Coordinate& cell, const Coordinate& direction) {
+                         tree.parents[cell] = direction;
+                       });
+  return tree;
+}
+
+}  // namespace Utils
+
+#endif  // UTILS_BFS_HH
@@ -0,0 +1,156 @@
+#ifndef UTILS_BIT_GRID_HH
+#define UTILS_BIT_GRID_HH
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "coordinate.hh"
+#include "grid.hh"
+
+namespace Utils {
+
+// Grid of bits, one per cell, packed into 64 bit words row by row (bit x % 64
+// of word x / 64 of a row is cell x). Every row ends with at least one unused
+// bit and the rows are framed by an unused row above and below, all kept
+// clear. Word kernels can then read the neighbours of any word of a row,
+// including across rows, without bounds checks.
+class BitGrid {
+  size_t width_{};
+  size_t height_{};
+  size_t stride_{};  // Words per row
+  std::vector<uint64_t> words_{};
+
+  [[nodiscard]] constexpr auto wordOf(const Coordinate& cell) const -> size_t {
+    return (static_cast<size_t>(cell.y) + 1) * stride_ +
+           static_cast<size_t>(cell.x) / 64;
+  }
+
+  [[nodiscard]] static constexpr auto bitOf(const Coordinate& cell)
+      -> uint64_t {
+    return uint64_t{1} << (static_cast<unsigned>(cell.x) % 64);
+  }
+
+  // First set x at or after from in row y. The spare bit at the end of every
+  // row keeps from == width_ inside the row.
+  [[nodiscard]] auto firstInRow(size_t y, size_t from) const
+      -> std::optional<size_t> {
+    const auto words = row(y);
+    auto word        = from / 64;
+    auto bits        = words[word] & (~uint64_t{} << (from % 64));
+    while (bits == 0) {
+      if (++word == stride_) return std::nullopt;
+      bits = words[word];
+    }
+    return word * 64 + static_cast<size_t>(std::countr_zero(bits));
+  }
+
+  // Last set x at or before from in row y
+  [[nodiscard]] auto lastInRow(size_t y, size_t from) const
+      -> std::optional<size_t> {
+    const auto words = row(y);
+    auto word        = from / 64;
+    auto bits        = words[word] & (~uint64_t{} >> (63 - from % 64));
+    while (bits == 0) {
+      if (word == 0) return std::nullopt;
+      bits = words[--word];
+    }
+    return word * 64 + 63 - static_cast<size_t>(std::countl_zero(bits));
+  }
+
+ public:
+  BitGrid() = default;
+
+  BitGrid(size_t width, size_t height)
+      : width_{width},
+        height_{height},
+        stride_{(width + 64) / 64},
+        words_((height + 2) * stride_) {}
+
+  // Sets the cells of a grid whose value satisfies predicate
+  template <typename STORE_AS, typename OOB_POLICY, typename LAYOUT>
+  [[nodiscard]] static auto from(
+      const Grid<STORE_AS, OOB_POLICY, LAYOUT>& grid, auto&& predicate)
+      -> BitGrid {
+    auto bits = BitGrid{grid.width(), grid.height()};
+    for (const auto cell : grid.coordinates())
+      if (predicate(grid[cell])) bits.set(cell);
+    return bits;
+  }
+
+  [[nodiscard]] constexpr auto width() const -> size_t { return width_; }
+  [[nodiscard]] constexpr auto height() const -> size_t { return height_; }
+  [[nodiscard]] constexpr auto stride() const -> size_t { return stride_; }
+
+  [[nodiscard]] constexpr auto inBounds(Coordinate cell) const -> bool {
+    return cell.x >= 0 and static_cast<size_t>(cell.x) < width_ and
+           cell.y >= 0 and static_cast<size_t>(cell.y) < height_;
+  }
+
+  // Cells outside the grid read as clear
+  [[nodiscard]] constexpr auto operator[](Coordinate cell) const -> bool {
+    return inBounds(cell) and (words_[wordOf(cell)] & bitOf(cell)) != 0;
+  }
+
+  constexpr void set(Coordinate cell) { words_[wordOf(cell)] |= bitOf(cell); }
+  constexpr void reset(Coordinate cell) {
+    words_[wordOf(cell)] &= ~bitOf(cell);
+  }
+
+  void clear() { std::ranges::fill(words_, 0); }
+
+  // Number of set cells
+  [[nodiscard]] auto count() const -> size_t {
+    auto total = size_t{};
+    for (const auto word : words_)
+      total += static_cast<size_t>(std::popcount(word));
+    return total;
+  }
+
+  // The stride() words of row y; the bits past width() are clear
+  [[nodiscard]] auto row(size_t y) -> std::span<uint64_t> {
+    return std::span{words_}.subspan((y + 1) * stride_, stride_);
+  }
+  [[nodiscard]] auto row(size_t y) const -> std::span<const uint64_t> {
+    return std::span{words_}.subspan((y + 1) * stride_, stride_);
+  }
+
+  // The first set cell past from (a cell of the grid) moving in an orthogonal
+  // direction, if there is one before the edge. Rows are searched a word at a
+  // time, columns a row at a time.
+  [[nodiscard]] auto nextSet(Coordinate from, Coordinate direction) const
+      -> std::optional<Coordinate> {
+    const auto x = static_cast<size_t>(from.x);
+    const auto y = static_cast<size_t>(from.y);
+    if (direction.y == 0) {
+      const auto found = direction.x > 0 ? firstInRow(y, x + 1)
+                         : x == 0        ? std::nullopt
+                                         : lastInRow(y, x - 1);
+      if (!found) return std::nullopt;
+      return Coordinate{static_cast<int>(*found), from.y};
+    }
+
+    const auto word = x / 64;
+    const auto bit  = uint64_t{1} << (x % 64);
+    for (auto at = y + static_cast<size_t>(direction.y); at < height_;
+         at += static_cast<size_t>(direction.y))
+      if ((words_[(at + 1) * stride_ + word] & bit) != 0)
+        return Coordinate{from.x, static_cast<int>(at)};
+    return std::nullopt;
+  }
+
+  // All the words, unused frame rows included: row y starts at word
+  // (y + 1) * stride()
+  [[nodiscard]] auto words() -> std::span<uint64_t> { return words_; }
+  [[nodiscard]] auto words() const -> std::span<const uint64_t> {
+    return words_;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_BIT_GRID_HH
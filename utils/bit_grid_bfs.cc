@@ -0,0 +1,133 @@
+#include "bit_grid_bfs.hh"
+
+#include <bit>
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using Utils::Detail::BitLayer;
+
+// Each of the expanders below works through the words [idx, to) of the
+// layer, adds the cells it reaches to count and returns where it stopped.
+
+auto scalarExpand(const BitLayer& layer, size_t idx, size_t to,
+                  size_t& count) -> size_t {
+  const auto& frontier = layer.frontier;
+  for (; idx != to; ++idx) {
+    const auto reach = (frontier[idx] << 1) | (frontier[idx - 1] >> 63) |
+                       (frontier[idx] >> 1) | (frontier[idx + 1] << 63) |
+                       frontier[idx - layer.stride] |
+                       frontier[idx + layer.stride];
+    const auto fresh = reach & layer.open[idx] & ~layer.visited[idx];
+    layer.next[idx] = fresh;
+    layer.visited[idx] |= fresh;
+    count += static_cast<size_t>(std::popcount(fresh));
+  }
+  return idx;
+}
+
+#if defined(__x86_64__)
+
+[[gnu::target("sse2")]] auto load128(const uint64_t* words) -> __m128i {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(words));  // NOLINT
+}
+
+[[gnu::target("avx2")]] auto load256(const uint64_t* words) -> __m256i {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));  // NOLINT
+}
+
+// SSE2 is part of x86-64 but POPCNT is not, so the counts are left to
+// std::popcount
+[[gnu::target("sse2")]] auto sse2Expand(const BitLayer& layer, size_t idx,
+                                        size_t to, size_t& count) -> size_t {
+  const auto* frontier = layer.frontier.data();
+  const auto stride    = layer.stride;
+  for (; idx + 2 <= to; idx += 2) {
+    const auto here  = load128(frontier + idx);
+    const auto reach = _mm_or_si128(
+        _mm_or_si128(
+            _mm_or_si128(_mm_slli_epi64(here, 1),
+                         _mm_srli_epi64(load128(frontier + idx - 1), 63)),
+            _mm_or_si128(_mm_srli_epi64(here, 1),
+                         _mm_slli_epi64(load128(frontier + idx + 1), 63))),
+        _mm_or_si128(load128(frontier + idx - stride),
+                     load128(frontier + idx + stride)));
+    const auto fresh = _mm_andnot_si128(
+        load128(layer.visited.data() + idx),
+        _mm_and_si128(reach, load128(layer.open.data() + idx)));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(layer.next.data() + idx),  // NOLINT
+        fresh);
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(layer.visited.data() + idx),  // NOLINT
+        _mm_or_si128(load128(layer.visited.data() + idx), fresh));
+    count += static_cast<size_t>(
+        std::popcount(static_cast<uint64_t>(_mm_cvtsi128_si64(fresh))) +
+        std::popcount(static_cast<uint64_t>(
+            _mm_cvtsi128_si64(_mm_unpackhi_epi64(fresh, fresh)))));
+  }
+  return idx;
+}
+
+[[gnu::target("avx2,popcnt")]] auto avx2Expand(const BitLayer& layer,
+                                               size_t idx, size_t to,
+                                               size_t& count) -> size_t {
+  const auto* frontier = layer.frontier.data();
+  const auto stride    = layer.stride;
+  for (; idx + 4 <= to; idx += 4) {
+    const auto here  = load256(frontier + idx);
+    const auto left  = _mm256_or_si256(
+        _mm256_slli_epi64(here, 1),
+        _mm256_srli_epi64(load256(frontier + idx - 1), 63));
+    const auto right = _mm256_or_si256(
+        _mm256_srli_epi64(here, 1),
+        _mm256_slli_epi64(load256(frontier + idx + 1), 63));
+    const auto reach = _mm256_or_si256(
+        _mm256_or_si256(left, right),
+        _mm256_or_si256(load256(frontier + idx - stride),
+                        load256(frontier + idx + stride)));
+    const auto fresh = _mm256_andnot_si256(
+        load256(layer.visited.data() + idx),
+        _mm256_and_si256(reach, load256(layer.open.data() + idx)));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(layer.next.data() + idx),  // NOLINT
+        fresh);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(layer.visited.data() + idx),  // NOLINT
+        _mm256_or_si256(load256(layer.visited.data() + idx), fresh));
+    count += static_cast<size_t>(
+        _mm_popcnt_u64(static_cast<uint64_t>(_mm256_extract_epi64(fresh, 0))) +
+        _mm_popcnt_u64(static_cast<uint64_t>(_mm256_extract_epi64(fresh, 1))) +
+        _mm_popcnt_u64(static_cast<uint64_t>(_mm256_extract_epi64(fresh, 2))) +
+        _mm_popcnt_u64(static_cast<uint64_t>(_mm256_extract_epi64(fresh, 3))));
+  }
+  return idx;
+}
+
+#endif
+
+}  // namespace
+
+namespace Utils::Detail {
+
+auto expandFrontier(const BitLayer& layer) -> size_t {
+  // The frame rows above and below are never expanded into
+  const auto from = layer.stride;
+  const auto to   = layer.open.size() - layer.stride;
+
+  auto count = size_t{};
+  auto idx   = from;
+#if defined(__x86_64__)
+  idx = __builtin_cpu_supports("avx2") and __builtin_cpu_supports("popcnt")
+            ? avx2Expand(layer, idx, to, count)
+            : sse2Expand(layer, idx, to, count);
+#endif
+  scalarExpand(layer, idx, to, count);
+  return count;
+}
+
+}  // namespace Utils::Detail
@@ -0,0 +1,51 @@
+#ifndef COORDINATE_INDEXER_HH
+#define COORDINATE_INDEXER_HH
+
+#include <cstddef>
+
+#include "coordinate.hh"
+#include "grid.hh"
+
+namespace Utils {
+
+// Row major index of the cells of a grid, for state-indexed searches and
+// graphs
+class CoordinateIndexer {
+  size_t width_{};
+  size_t height_{};
+
+ public:
+  constexpr CoordinateIndexer(size_t width, size_t height)
+      : width_{width}, height_{height} {}
+
+  template <typename STORE_AS, typename OOB_POLICY, typename LAYOUT>
+  constexpr explicit CoordinateIndexer(
+      const Grid<STORE_AS, OOB_POLICY, LAYOUT>& grid)
+      : CoordinateIndexer{grid.width(), grid.height()} {}
+
+  [[nodiscard]] constexpr auto operator()(const Coordinate& coordinate) const
+      -> size_t {
+    return static_cast<size_t>(coordinate.y) * width_ +
+           static_cast<size_t>(coordinate.x);
+  }
+
+  [[nodiscard]] constexpr auto contains(const Coordinate& coordinate) const
+      -> bool {
+    return coordinate.x >= 0 and coordinate.y >= 0 and
+           static_cast<size_t>(coordinate.x) < width_ and
+           static_cast<size_t>(coordinate.y) < height_;
+  }
+
+  [[nodiscard]] constexpr auto stateAt(size_t idx) const -> Coordinate {
+    return {.x = static_cast<int>(idx % width_),
+            .y = static_cast<int>(idx / width_)};
+  }
+
+  [[nodiscard]] constexpr auto size() const -> size_t {
+    return width_ * height_;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // COORDINATE_INDEXER_HH
@@ -1,22 +1,33 @@
 #ifndef COORDINATE_MAP_HH
 #define COORDINATE_MAP_HH
 
-#include <unordered_map>
+#include <cstdint>
 
 #include "coordinate.hh"
+#include "flat_map.hh"
 
 namespace Utils {
 
+namespace Detail {
+
+[[nodiscard]] constexpr auto packed(const Coordinate& coord) -> uint64_t {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(coord.x)) << 32U) |
+         static_cast<uint32_t>(coord.y);
+}
+
+}  // namespace Detail
+
 struct CoordinateHash {
+  using is_avalanching = void;
+
   [[nodiscard]] constexpr auto operator()(const Coordinate& coord) const
       -> size_t {
-    return static_cast<size_t>(std::hash<int>()(coord.x) ^
-                               std::hash<int>()(coord.y));
+    return static_cast<size_t>(mixHash(Detail::packed(coord)));
   }
 };
 
 template <typename T>
-using CoordinateMap = std::unordered_map<Coordinate, T, CoordinateHash>;
+using CoordinateMap = FlatMap<Coordinate, T, CoordinateHash>;
 
 }  // namespace Utils
 
@@ -24,6 +35,8 @@ namespace std {
 
 template <>
 struct hash<Utils::Coordinate> {
+  using is_avalanching = void;
+
   [[nodiscard]] auto operator()(
       const Utils::Coordinate& coordinate) const noexcept -> size_t {
     return Utils::CoordinateHash()(coordinate);
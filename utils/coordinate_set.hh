@@ -1,42 +1,136 @@
 #ifndef COORDINATE_SET_HH
 #define COORDINATE_SET_HH
 
-#include <bitset>
+#include <algorithm>
+#include <bit>
 #include <cstdint>
-#include <limits>
 #include <ranges>
+#include <utility>
+#include <vector>
 
 #include "coordinate.hh"
 
 namespace Utils {
 
+// Dense bit set over a rectangle of coordinates. Size it up front to the grid
+// it indexes; inserting outside of the current rectangle grows it (doubling
+// in the direction of growth), so coordinates never alias.
 class CoordinateSet {
-  using Bits = std::bitset<std::numeric_limits<uint16_t>::max()>;
+  using Word                        = uint64_t;
+  static constexpr size_t WORD_BITS = 64;
 
-  Bits bits_{};
+  Coordinate origin_{};
+  size_t width_{};
+  size_t height_{};
+  std::vector<Word> words_{};
 
-  [[nodiscard]] static constexpr auto idxFor(const Coordinate& coordinate)
-      -> uint16_t {
-    return static_cast<uint16_t>(
-        (static_cast<uint16_t>(coordinate.y) << 8) +    // NOLINT
-        (static_cast<uint16_t>(coordinate.x) & 0xFF));  // NOLINT
+  CoordinateSet(Coordinate origin, size_t width, size_t height)
+      : origin_{origin},
+        width_{width},
+        height_{height},
+        words_((width * height + WORD_BITS - 1) / WORD_BITS) {}
+
+  [[nodiscard]] constexpr auto inBounds(const Coordinate& coordinate) const
+      -> bool {
+    return coordinate.x >= origin_.x and coordinate.y >= origin_.y and
+           static_cast<size_t>(coordinate.x - origin_.x) < width_ and
+           static_cast<size_t>(coordinate.y - origin_.y) < height_;
+  }
+
+  [[nodiscard]] constexpr auto idxFor(const Coordinate& coordinate) const
+      -> size_t {
+    return static_cast<size_t>(coordinate.y - origin_.y) * width_ +
+           static_cast<size_t>(coordinate.x - origin_.x);
+  }
+
+  [[nodiscard]] constexpr auto coordinateFor(size_t idx) const -> Coordinate {
+    return {.x = origin_.x + static_cast<int>(idx % width_),
+            .y = origin_.y + static_cast<int>(idx / width_)};
+  }
+
+  [[nodiscard]] constexpr auto test(size_t idx) const -> bool {
+    return ((words_[idx / WORD_BITS] >> (idx % WORD_BITS)) & 1) != 0;
+  }
+
+  [[nodiscard]] constexpr auto sameShapeAs(const CoordinateSet& other) const
+      -> bool {
+    return origin_ == other.origin_ and width_ == other.width_ and
+           height_ == other.height_;
+  }
+
+  // Number of bits set in [from, to)
+  [[nodiscard]] constexpr auto countBits(size_t from, size_t to) const
+      -> size_t {
+    if (from >= to) return 0;
+    const auto first = from / WORD_BITS;
+    const auto last  = (to - 1) / WORD_BITS;
+    const auto head  = ~Word{} << (from % WORD_BITS);
+    const auto tail  = ~Word{} >> (WORD_BITS - 1 - (to - 1) % WORD_BITS);
+
+    if (first == last)
+      return static_cast<size_t>(std::popcount(words_[first] & head & tail));
+
+    auto total = static_cast<size_t>(std::popcount(words_[first] & head));
+    for (auto word = first + 1; word != last; ++word)
+      total += static_cast<size_t>(std::popcount(words_[word]));
+    return total + static_cast<size_t>(std::popcount(words_[last] & tail));
+  }
+
+  void growToInclude(const Coordinate& coordinate) {
+    const auto width  = static_cast<int>(width_);
+    const auto height = static_cast<int>(height_);
+
+    auto low  = Coordinate{std::min(origin_.x, coordinate.x),
+                          std::min(origin_.y, coordinate.y)};
+    auto high = Coordinate{std::max(origin_.x + width, coordinate.x + 1),
+                           std::max(origin_.y + height, coordinate.y + 1)};
+
+    // Leave room to grow in the same direction again
+    if (low.x < origin_.x) low.x -= width;
+    if (low.y < origin_.y) low.y -= height;
+    if (high.x > origin_.x + width) high.x += width;
+    if (high.y > origin_.y + height) high.y += height;
+
+    auto grown = CoordinateSet{low, static_cast<size_t>(high.x - low.x),
+                               static_cast<size_t>(high.y - low.y)};
+    for (const auto existing : *this) grown.insert(existing);
+    *this = std::move(grown);
   }
 
  public:
   class Iterator {
-    const Bits* bits_p_{nullptr};
+    const CoordinateSet* set_p_{nullptr};
     size_t idx_{};
 
     friend CoordinateSet;
-    constexpr explicit Iterator(const Bits* bits, size_t idx)
-        : bits_p_{bits}, idx_{idx} {
-      if (idx_ < bits_p_->size() and !bits_p_->test(idx)) advance();
+    constexpr explicit Iterator(const CoordinateSet* set, size_t idx)
+        : set_p_{set}, idx_{idx} {
+      seek();
+    }
+
+    // Moves to the first set bit at or after idx_, a word at a time
+    constexpr void seek() {
+      const auto& words = set_p_->words_;
+      auto word         = idx_ / WORD_BITS;
+      if (word >= words.size()) {
+        idx_ = set_p_->size();
+        return;
+      }
+
+      auto bits = words[word] & (~Word{} << (idx_ % WORD_BITS));
+      while (bits == 0) {
+        if (++word == words.size()) {
+          idx_ = set_p_->size();
+          return;
+        }
+        bits = words[word];
+      }
+      idx_ = word * WORD_BITS + static_cast<size_t>(std::countr_zero(bits));
     }
 
-    void advance() {
-      do {
-        ++idx_;
-      } while (idx_ < bits_p_->size() and !bits_p_->test(idx_));
+    constexpr void advance() {
+      ++idx_;
+      seek();
     }
 
    public:
@@ -46,8 +140,7 @@ class CoordinateSet {
     Iterator() = default;
 
     [[nodiscard]] constexpr auto operator*() const -> Coordinate {
-      return {.x = static_cast<int>(idx_ & 0xFF),  // NOLINT
-              .y = static_cast<int>(idx_ >> 8)};   // NOLINT
+      return set_p_->coordinateFor(idx_);
     }
 
     constexpr auto operator++() -> Iterator& {
@@ -70,6 +163,9 @@ class CoordinateSet {
 
   CoordinateSet() = default;
 
+  CoordinateSet(size_t width, size_t height)
+      : CoordinateSet{Coordinate{}, width, height} {}
+
   explicit CoordinateSet(Coordinate coordinate) { insert(coordinate); }
 
   template <typename RANGE>
@@ -77,20 +173,30 @@ class CoordinateSet {
     for (auto coordinate : range) insert(coordinate);
   }
 
-  constexpr void insert(const Coordinate& coordinate) {
-    bits_.set(idxFor(coordinate));
+  template <typename RANGE>
+  CoordinateSet(std::from_range_t /*unused*/, RANGE&& range, size_t width,
+                size_t height)
+      : CoordinateSet{width, height} {
+    for (auto coordinate : range) insert(coordinate);
+  }
+
+  void insert(const Coordinate& coordinate) {
+    if (!inBounds(coordinate)) growToInclude(coordinate);
+    const auto idx = idxFor(coordinate);
+    words_[idx / WORD_BITS] |= Word{1} << (idx % WORD_BITS);
   }
 
   constexpr void erase(const Coordinate& coordinate) {
-    bits_.reset(idxFor(coordinate));
+    if (!inBounds(coordinate)) return;
+    const auto idx = idxFor(coordinate);
+    words_[idx / WORD_BITS] &= ~(Word{1} << (idx % WORD_BITS));
   }
 
-  constexpr void clear() { bits_ = 0; }
+  constexpr void clear() { std::ranges::fill(words_, Word{}); }
 
   [[nodiscard]] constexpr auto contains(const Coordinate& coordinate) const
       -> bool {
-    const auto idx = idxFor(coordinate);
-    return idx < bits_.size() and bits_.test(idx);
+    return inBounds(coordinate) and test(idxFor(coordinate));
   }
 
   [[nodiscard]] constexpr auto operator[](const Coordinate& coordinate) const
@@ -98,22 +204,97 @@ class CoordinateSet {
     return contains(coordinate);
   }
 
-  [[nodiscard]] constexpr auto size() const -> size_t { return bits_.size(); }
+  [[nodiscard]] constexpr auto size() const -> size_t {
+    return width_ * height_;
+  }
+
+  [[nodiscard]] constexpr auto count() const -> size_t {
+    auto total = size_t{};
+    for (const auto word : words_)
+      total += static_cast<size_t>(std::popcount(word));
+    return total;
+  }
+
+  // Number of coordinates in the rectangle [from, to)
+  [[nodiscard]] constexpr auto count(Coordinate from, Coordinate to) const
+      -> size_t {
+    from = {.x = std::max(from.x, origin_.x), .y = std::max(from.y, origin_.y)};
+    to   = {.x = std::min(to.x, origin_.x + static_cast<int>(width_)),
+            .y = std::min(to.y, origin_.y + static_cast<int>(height_))};
+    if (from.x >= to.x) return 0;
+
+    const auto length = static_cast<size_t>(to.x - from.x);
+    auto total        = size_t{};
+    for (auto row = from; row.y < to.y; ++row.y) {
+      const auto idx = idxFor(row);
+      total += countBits(idx, idx + length);
+    }
+    return total;
+  }
+
+  [[nodiscard]] constexpr auto empty() const -> bool {
+    return std::ranges::all_of(words_, [](auto word) { return word == 0; });
+  }
+
+  // Set algebra; sets of the same shape combine a word at a time
+
+  auto operator|=(const CoordinateSet& other) -> CoordinateSet& {
+    if (!sameShapeAs(other)) {
+      for (const auto coordinate : other) insert(coordinate);
+      return *this;
+    }
+    for (size_t word = 0; word != words_.size(); ++word)
+      words_[word] |= other.words_[word];
+    return *this;
+  }
+
+  constexpr auto operator&=(const CoordinateSet& other) -> CoordinateSet& {
+    if (!sameShapeAs(other)) {
+      for (const auto coordinate : *this)
+        if (!other.contains(coordinate)) erase(coordinate);
+      return *this;
+    }
+    for (size_t word = 0; word != words_.size(); ++word)
+      words_[word] &= other.words_[word];
+    return *this;
+  }
 
-  [[nodiscard]] constexpr auto count() const -> size_t { return bits_.count(); }
+  constexpr auto operator-=(const CoordinateSet& other) -> CoordinateSet& {
+    if (!sameShapeAs(other)) {
+      for (const auto coordinate : other) erase(coordinate);
+      return *this;
+    }
+    for (size_t word = 0; word != words_.size(); ++word)
+      words_[word] &= ~other.words_[word];
+    return *this;
+  }
 
-  [[nodiscard]] constexpr auto empty() const -> bool { return bits_.none(); }
+  [[nodiscard]] friend auto operator|(CoordinateSet lhs,
+                                      const CoordinateSet& rhs)
+      -> CoordinateSet {
+    return lhs |= rhs;
+  }
+
+  [[nodiscard]] friend auto operator&(CoordinateSet lhs,
+                                      const CoordinateSet& rhs)
+      -> CoordinateSet {
+    return lhs &= rhs;
+  }
+
+  [[nodiscard]] friend auto operator-(CoordinateSet lhs,
+                                      const CoordinateSet& rhs)
+      -> CoordinateSet {
+    return lhs -= rhs;
+  }
 
   [[nodiscard]] constexpr auto begin() const -> Iterator {
-    return Iterator{&bits_, 0};
+    return Iterator{this, 0};
   }
 
   [[nodiscard]] constexpr auto end() const -> Iterator {
-    return Iterator{&bits_, bits_.size()};
+    return Iterator{this, size()};
   }
 };
 }  // namespace Utils
 
 #endif  // COORDINATE_SET_HH
-
-
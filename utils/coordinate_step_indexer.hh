@@ -0,0 +1,69 @@
+#ifndef COORDINATE_STEP_INDEXER_HH
+#define COORDINATE_STEP_INDEXER_HH
+
+#include <cmath>
+#include <cstddef>
+
+#include "coordinate.hh"
+#include "coordinate_directions.hh"
+#include "coordinate_step.hh"
+#include "grid.hh"
+
+namespace Utils {
+
+namespace Detail {
+
+// Index of an orthogonal unit direction in Directions::orthogonal()
+[[nodiscard]] constexpr auto orthogonalIndex(const Coordinate& direction)
+    -> size_t {
+  if (direction.x == 0) return direction.y < 0 ? 0 : 2;
+  return direction.x > 0 ? 1 : 3;
+}
+
+}  // namespace Detail
+
+// Index of the steps on a grid (cell major, then by orthogonal direction), for
+// state-indexed searches and graphs
+class StepIndexer {
+  size_t width_{};
+  size_t height_{};
+
+ public:
+  constexpr StepIndexer(size_t width, size_t height)
+      : width_{width}, height_{height} {}
+
+  template <typename STORE_AS, typename OOB_POLICY, typename LAYOUT>
+  constexpr explicit StepIndexer(
+      const Grid<STORE_AS, OOB_POLICY, LAYOUT>& grid)
+      : StepIndexer{grid.width(), grid.height()} {}
+
+  [[nodiscard]] constexpr auto operator()(const Step& step) const -> size_t {
+    const auto cell = static_cast<size_t>(step.position.y) * width_ +
+                      static_cast<size_t>(step.position.x);
+    return cell * 4 + Detail::orthogonalIndex(step.direction);
+  }
+
+  // Within the grid, and facing one of the orthogonal directions
+  [[nodiscard]] constexpr auto contains(const Step& step) const -> bool {
+    const auto& [position, direction] = step;
+    return position.x >= 0 and position.y >= 0 and
+           static_cast<size_t>(position.x) < width_ and
+           static_cast<size_t>(position.y) < height_ and
+           std::abs(direction.x) + std::abs(direction.y) == 1;
+  }
+
+  [[nodiscard]] constexpr auto stateAt(size_t idx) const -> Step {
+    const auto cell = idx / 4;
+    return {.position  = {.x = static_cast<int>(cell % width_),
+                          .y = static_cast<int>(cell / width_)},
+            .direction = Directions::orthogonal()[idx % 4]};
+  }
+
+  [[nodiscard]] constexpr auto size() const -> size_t {
+    return width_ * height_ * 4;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // COORDINATE_STEP_INDEXER_HH
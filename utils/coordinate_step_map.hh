@@ -1,22 +1,23 @@
 #ifndef COORDINATE_STEP_MAP_HH
 #define COORDINATE_STEP_MAP_HH
 
-#include <unordered_map>
-
 #include "coordinate_map.hh"
 #include "coordinate_step.hh"
+#include "flat_map.hh"
 
 namespace Utils {
 
 struct StepHash {
+  using is_avalanching = void;
+
   [[nodiscard]] constexpr auto operator()(const Step& step) const -> size_t {
-    return static_cast<size_t>(Utils::CoordinateHash()(step.position) ^
-                               Utils::CoordinateHash()(step.direction));
+    return static_cast<size_t>(mixHash(Detail::packed(step.position) ^
+                                       mixHash(Detail::packed(step.direction))));
   }
 };
 
 template <typename T>
-using StepMap = std::unordered_map<Step, T, StepHash>;
+using StepMap = FlatMap<Step, T, StepHash>;
 
 }  // namespace Utils
 
@@ -24,6 +25,8 @@ namespace std {
 
 template <>
 struct hash<Utils::Step> {
+  using is_avalanching = void;
+
   [[nodiscard]] auto operator()(const Utils::Step& step) const noexcept
       -> size_t {
     return Utils::StepHash()(step);
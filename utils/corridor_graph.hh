@@ -0,0 +1,220 @@
+#ifndef UTILS_CORRIDOR_GRAPH_HH
+#define UTILS_CORRIDOR_GRAPH_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include "coordinate.hh"
+#include "coordinate_directions.hh"
+#include "coordinate_indexer.hh"
+#include "coordinate_step.hh"
+#include "coordinate_step_indexer.hh"
+#include "dijkstras.hh"
+#include "grid.hh"
+#include "weighted_edge.hh"
+
+namespace Utils {
+
+// A maze with its corridors contracted. Junctions are the passable cells that
+// do not have exactly two passable neighbours, plus any cells asked to be
+// kept (a start or a finish, say). Every other passable cell lies on exactly
+// one corridor: a chain of such cells between two junctions.
+//
+// Searches run over the junctions only, either by cell (operator()) or by
+// Step with a cost per turn (steps()); the cells of the corridors can be
+// recovered afterwards.
+template <typename DISTANCE = int>
+class CorridorGraph {
+ public:
+  struct Corridor {
+    Step leaving;        // Junction it starts at, direction of the first move
+    Step arriving;       // Junction it ends at, direction of the last move
+    DISTANCE length;     // Moves
+    DISTANCE turns;
+    DISTANCE to_corner;  // Moves to its first turn, if it turns
+  };
+
+ private:
+  static constexpr auto NONE = std::numeric_limits<uint32_t>::max();
+
+  CoordinateIndexer cells_;
+  StepIndexer steps_;
+  std::vector<bool> junctions_;
+  std::vector<uint32_t> leaving_;  // Corridor leaving each step, or NONE
+  std::vector<Corridor> corridors_{};
+  std::vector<uint32_t> offsets_{0};
+  std::vector<Coordinate> inner_{};  // Cells between the two junctions
+
+  [[nodiscard]] auto idOf(const Step& leaving) const -> uint32_t {
+    return leaving_[steps_(leaving)];
+  }
+
+ public:
+  using Edge     = WeightedEdge<DISTANCE, Coordinate>;
+  using StepEdge = WeightedEdge<DISTANCE, Step>;
+
+  template <typename STORE_AS, typename OOB_POLICY, typename LAYOUT>
+  CorridorGraph(const Grid<STORE_AS, OOB_POLICY, LAYOUT>& grid,
+                auto&& passable, std::span<const Coordinate> keep = {})
+      : cells_{grid},
+        steps_{grid},
+        junctions_(cells_.size()),
+        leaving_(steps_.size(), NONE) {
+    const auto open = [&](const Coordinate& cell) {
+      return grid.inBounds(cell) and passable(grid[cell]);
+    };
+    const auto degree = [&](const Coordinate& cell) {
+      return std::ranges::count_if(
+          Directions::orthogonal(),
+          [&](const auto& direction) { return open(cell + direction); });
+    };
+
+    for (const auto cell : grid.coordinates())
+      junctions_[cells_(cell)] = open(cell) and degree(cell) != 2;
+    for (const auto cell : keep)
+      if (open(cell)) junctions_[cells_(cell)] = true;
+
+    for (const auto from : grid.coordinates()) {
+      if (!junction(from)) continue;
+      for (const auto leaving : Directions::orthogonal()) {
+        if (!open(from + leaving)) continue;
+
+        auto at        = from + leaving;
+        auto direction = leaving;
+        auto length    = DISTANCE{1};
+        auto turns     = DISTANCE{};
+        auto to_corner = DISTANCE{};
+        while (!junction(at)) {
+          inner_.push_back(at);
+          for (const auto next :
+               {direction, rotatedClockwise(direction),
+                rotatedCounterClockwise(direction)}) {
+            if (!open(at + next)) continue;
+            if (next != direction and turns++ == 0) to_corner = length;
+            direction = next;
+            break;
+          }
+          at += direction;
+          ++length;
+        }
+
+        leaving_[steps_({from, leaving})] =
+            static_cast<uint32_t>(corridors_.size());
+        corridors_.push_back({.leaving  = {from, leaving},
+                              .arriving = {at, direction},
+                              .length    = length,
+                              .turns     = turns,
+                              .to_corner = to_corner});
+        offsets_.push_back(static_cast<uint32_t>(inner_.size()));
+      }
+    }
+  }
+
+  [[nodiscard]] auto junction(const Coordinate& cell) const -> bool {
+    return junctions_[cells_(cell)];
+  }
+
+  [[nodiscard]] auto corridors() const -> std::span<const Corridor> {
+    return corridors_;
+  }
+
+  // The corridor leaving a junction in a direction, if there is one
+  [[nodiscard]] auto corridorFrom(const Step& leaving) const
+      -> std::optional<Corridor> {
+    const auto id = idOf(leaving);
+    if (id == NONE) return std::nullopt;
+    return corridors_[id];
+  }
+
+  // The cells strictly between the two junctions of a corridor, in order
+  [[nodiscard]] auto cellsAlong(const Step& leaving) const
+      -> std::span<const Coordinate> {
+    const auto id = idOf(leaving);
+    if (id == NONE) return {};
+    return std::span{inner_}.subspan(offsets_[id],
+                                     offsets_[id + 1] - offsets_[id]);
+  }
+
+  [[nodiscard]] auto indexer() const -> const CoordinateIndexer& {
+    return cells_;
+  }
+
+  [[nodiscard]] auto stepIndexer() const -> const StepIndexer& {
+    return steps_;
+  }
+
+  // Adjacency by cell: calls visit(Edge) for every corridor out of from
+  void operator()(const Coordinate& from, auto&& visit) const {
+    for (const auto direction : Directions::orthogonal())
+      if (const auto corridor = corridorFrom({from, direction}))
+        visit(Edge{corridor->length, corridor->arriving.position});
+  }
+
+  // Adjacency by Step, facing one way at a time: follow the corridor ahead,
+  // paying turn_cost for each of its turns, or turn towards another corridor.
+  // Turning twice at a corner of the corridor is the one way to turn around
+  // inside it, which takes the search back to the junction it left.
+  [[nodiscard]] auto steps(DISTANCE turn_cost) const {
+    return [this, turn_cost](const Step& from, auto&& visit) {
+      if (const auto corridor = corridorFrom(from)) {
+        visit(StepEdge{corridor->length + corridor->turns * turn_cost,
+                       corridor->arriving});
+        if (corridor->turns != 0)
+          visit(StepEdge{2 * (corridor->to_corner + turn_cost),
+                         {from.position, from.direction * -1}});
+      }
+      for (const auto direction : {rotatedCounterClockwise(from.direction),
+                                   rotatedClockwise(from.direction)})
+        if (corridorFrom({from.position, direction}))
+          visit(StepEdge{turn_cost, {from.position, direction}});
+    };
+  }
+
+  // Every cell on any shortest path to one of the targets, given the result
+  // of a search over steps(turn_cost). Cells may be listed more than once.
+  template <state_indexer<Step> INDEXER>
+  [[nodiscard]] auto cellsOnShortestPaths(
+      const ShortestPaths<DISTANCE, Step, INDEXER>& paths,
+      std::ranges::input_range auto&& targets, DISTANCE turn_cost) const
+      -> std::vector<Coordinate> {
+    const auto states = paths.onShortestPaths(targets);
+
+    auto on_paths = std::vector<bool>(steps_.size());
+    auto cells    = std::vector<Coordinate>{};
+    for (const auto& state : states) {
+      on_paths[steps_(state)] = true;
+      cells.push_back(state.position);
+    }
+
+    // A corridor (or the way to its first corner and back) is on a shortest
+    // path when both of its ends are, and it is tight between them
+    const auto tight = [&](const Step& from, const Step& to, DISTANCE cost) {
+      return on_paths[steps_(to)] and
+             paths.distance(from) + cost == paths.distance(to);
+    };
+    for (const auto& state : states) {
+      const auto corridor = corridorFrom(state);
+      if (!corridor) continue;
+      const auto along = cellsAlong(state);
+      if (tight(state, corridor->arriving,
+                corridor->length + corridor->turns * turn_cost))
+        cells.insert(cells.end(), along.begin(), along.end());
+      else if (corridor->turns != 0 and
+               tight(state, {state.position, state.direction * -1},
+                     2 * (corridor->to_corner + turn_cost)))
+        cells.insert(cells.end(), along.begin(),
+                     along.begin() + corridor->to_corner);
+    }
+    return cells;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_CORRIDOR_GRAPH_HH
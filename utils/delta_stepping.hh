@@ -0,0 +1,193 @@
+#ifndef UTILS_DELTA_STEPPING_HH
+#define UTILS_DELTA_STEPPING_HH
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dijkstras.hh"
+#include "weighted_edge.hh"
+
+namespace Utils {
+
+// Distances from the start of a search to every indexed state
+template <typename DISTANCE, typename EDGE, state_indexer<EDGE> INDEXER>
+class StateDistances {
+  INDEXER index_;
+  std::vector<DISTANCE> distances_;
+
+ public:
+  StateDistances(const INDEXER& index, std::vector<DISTANCE> distances)
+      : index_{index}, distances_{std::move(distances)} {}
+
+  [[nodiscard]] auto distance(const EDGE& state) const -> DISTANCE {
+    return distances_[index_(state)];
+  }
+
+  [[nodiscard]] auto reached(const EDGE& state) const -> bool {
+    return distance(state) != std::numeric_limits<DISTANCE>::max();
+  }
+
+  [[nodiscard]] auto distanceAt(size_t idx) const -> DISTANCE {
+    return distances_[idx];
+  }
+};
+
+namespace Detail {
+
+// Lowers best to distance; true if this call did so
+template <typename DISTANCE>
+auto lowerTo(std::atomic<DISTANCE>& best, DISTANCE distance) -> bool {
+  auto current = best.load(std::memory_order_relaxed);
+  while (distance < current)
+    if (best.compare_exchange_weak(current, distance,
+                                   std::memory_order_relaxed))
+      return true;
+  return false;
+}
+
+}  // namespace Detail
+
+// Parallel delta-stepping (Meyer & Sanders). States are kept in buckets of
+// width delta and the buckets are settled in order. Edges of at most delta
+// are light: they are relaxed until the current bucket stays empty. Heavy
+// edges cannot land in the current bucket, so they are relaxed once per
+// settled state afterwards. Every round relaxes its states on all threads;
+// adjacent is called concurrently and must be safe to do so. The distances
+// are the same as those of the sequential dijkstra. A thread count of zero
+// runs on one thread.
+template <typename DISTANCE, typename EDGE, state_indexer<EDGE> INDEXER>
+[[nodiscard]] auto deltaStepping(
+    WeightedEdge<DISTANCE, EDGE> start, auto&& adjacent, const INDEXER& index,
+    DISTANCE delta,
+    size_t threads = std::thread::hardware_concurrency())
+    -> StateDistances<DISTANCE, EDGE, INDEXER> {
+  threads = std::max<size_t>(1, threads);
+  enum class Round : uint8_t { LIGHT, HEAVY, DONE };
+  static constexpr auto NO_PATH = std::numeric_limits<DISTANCE>::max();
+  static constexpr auto CHUNK   = size_t{256};
+
+  auto distances = std::vector<std::atomic<DISTANCE>>(index.size());
+  for (auto& distance : distances)
+    distance.store(NO_PATH, std::memory_order_relaxed);
+
+  auto buckets  = std::vector<std::vector<size_t>>{};
+  auto outboxes = std::vector<std::vector<size_t>>(threads);
+  auto frontier = std::vector<size_t>{};
+  auto settled  = std::vector<size_t>{};  // Taken from the current bucket
+  auto bucket   = size_t{};
+  auto round    = Round::LIGHT;
+  auto cursor   = std::atomic<size_t>{};
+
+  const auto bucketOf = [&](size_t idx) {
+    return static_cast<size_t>(
+        distances[idx].load(std::memory_order_relaxed) / delta);
+  };
+
+  const auto file = [&](size_t idx) {
+    const auto to = bucketOf(idx);
+    if (to >= buckets.size()) buckets.resize(to + 1);
+    buckets[to].push_back(idx);
+  };
+
+  const auto distinct = [](std::vector<size_t>& states) {
+    std::ranges::sort(states);
+    states.erase(std::ranges::unique(states).begin(), states.end());
+  };
+
+  // States whose distance was lowered to another bucket are left behind as
+  // stale entries and skipped here
+  const auto takeBucket = [&] {
+    frontier.clear();
+    for (const auto idx : std::exchange(buckets[bucket], {}))
+      if (bucketOf(idx) == bucket) frontier.push_back(idx);
+    distinct(frontier);
+    settled.insert(settled.end(), frontier.begin(), frontier.end());
+  };
+
+  // Runs on one thread between rounds
+  const auto nextRound = [&]() noexcept {
+    for (auto& outbox : outboxes) {
+      for (const auto idx : outbox) file(idx);
+      outbox.clear();
+    }
+    cursor.store(0, std::memory_order_relaxed);
+
+    if (round == Round::LIGHT) {
+      if (buckets[bucket].empty()) {
+        frontier = std::exchange(settled, {});
+        distinct(frontier);
+        round = Round::HEAVY;
+      } else {
+        takeBucket();
+      }
+      return;
+    }
+
+    while (++bucket < buckets.size() and buckets[bucket].empty()) {}
+    if (bucket == buckets.size()) {
+      round = Round::DONE;
+    } else {
+      round = Round::LIGHT;
+      takeBucket();
+    }
+  };
+
+  const auto relaxFrontier = [&](size_t thread) {
+    auto& outbox     = outboxes[thread];
+    const auto heavy = round == Round::HEAVY;
+    for (auto first = cursor.fetch_add(CHUNK); first < frontier.size();
+         first      = cursor.fetch_add(CHUNK)) {
+      const auto count = std::min(CHUNK, frontier.size() - first);
+      for (const auto from : std::span{frontier}.subspan(first, count)) {
+        const auto distance = distances[from].load(std::memory_order_relaxed);
+        Detail::forEachAdjacent(
+            adjacent, index.stateAt(from), [&](const auto& adjacent_edge) {
+              const auto [distance_to, other] = adjacent_edge;
+              if ((distance_to > delta) != heavy) return;
+              const auto to = index(other);
+              if (Detail::lowerTo(distances[to], distance + distance_to))
+                outbox.push_back(to);
+            });
+      }
+    }
+  };
+
+  const auto from = index(start.edge);
+  distances[from].store(start.distance, std::memory_order_relaxed);
+  file(from);
+  bucket = bucketOf(from);
+  takeBucket();
+
+  auto sync = std::barrier{static_cast<std::ptrdiff_t>(threads), nextRound};
+  const auto work = [&](size_t thread) {
+    while (round != Round::DONE) {
+      relaxFrontier(thread);
+      sync.arrive_and_wait();
+    }
+  };
+
+  {
+    auto workers = std::vector<std::jthread>{};
+    for (auto thread = size_t{1}; thread < threads; ++thread)
+      workers.emplace_back(work, thread);
+    work(0);
+  }
+
+  auto result = std::vector<DISTANCE>{};
+  result.reserve(distances.size());
+  for (const auto& distance : distances)
+    result.push_back(distance.load(std::memory_order_relaxed));
+  return {index, std::move(result)};
+}
+
+}  // namespace Utils
+
+#endif  // UTILS_DELTA_STEPPING_HH
@@ -0,0 +1,18 @@
+#ifndef DENSE_COORDINATE_MAP_HH
+#define DENSE_COORDINATE_MAP_HH
+
+#include <limits>
+
+#include "coordinate.hh"
+#include "coordinate_indexer.hh"
+#include "dense_map.hh"
+
+namespace Utils {
+
+// Drop-in for CoordinateMap when every key is a cell of one grid
+template <typename T, auto UNSET = std::numeric_limits<T>::max()>
+using DenseCoordinateMap = DenseMap<Coordinate, T, CoordinateIndexer, UNSET>;
+
+}  // namespace Utils
+
+#endif  // DENSE_COORDINATE_MAP_HH
@@ -0,0 +1,211 @@
+#ifndef DENSE_MAP_HH
+#define DENSE_MAP_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "grid.hh"
+
+namespace Utils {
+
+// Map from the states of a grid of known size (as numbered by INDEXER),
+// stored as one value per state. States holding UNSET are not in the map, so
+// UNSET must never be stored. Offers the lookup, insertion and iteration of
+// FlatMap; iterators and references stay valid until the map is destroyed.
+template <typename KEY, typename T, typename INDEXER,
+          auto UNSET = std::numeric_limits<T>::max()>
+class DenseMap {
+ public:
+  using key_type    = KEY;
+  using mapped_type = T;
+  using value_type  = std::pair<const KEY, T>;
+
+ private:
+  INDEXER index_;
+  std::vector<T> values_;
+  size_t size_{};
+
+  template <bool CONST>
+  class IteratorBase {
+    using Map = std::conditional_t<CONST, const DenseMap, DenseMap>;
+    Map* map_p_{nullptr};
+    size_t idx_{};
+
+    friend DenseMap;
+    constexpr IteratorBase(Map* map, size_t idx) : map_p_{map}, idx_{idx} {}
+
+    constexpr void skipUnset() {
+      while (idx_ != map_p_->values_.size() and
+             map_p_->values_[idx_] == UNSET)
+        ++idx_;
+    }
+
+   public:
+    using iterator_concept = std::forward_iterator_tag;
+    using difference_type  = std::ptrdiff_t;
+    // Pairs of the key and a reference to its value, made on the fly
+    using value_type =
+        std::pair<const KEY, std::conditional_t<CONST, const T&, T&>>;
+    using reference = value_type;
+
+    // Keys are not stored, so operator-> hands out a reference it holds
+    struct Arrow {
+      reference value;
+
+      [[nodiscard]] constexpr auto operator->() -> reference* {
+        return &value;
+      }
+    };
+
+    IteratorBase() = default;
+
+    // const_iterator from iterator
+    template <bool OTHER>
+      requires(CONST and !OTHER)
+    constexpr IteratorBase(const IteratorBase<OTHER>& other)  // NOLINT
+        : map_p_{other.map_p_}, idx_{other.idx_} {}
+
+    [[nodiscard]] constexpr auto operator*() const -> reference {
+      return {map_p_->index_.stateAt(idx_), map_p_->values_[idx_]};
+    }
+
+    [[nodiscard]] constexpr auto operator->() const -> Arrow {
+      return {**this};
+    }
+
+    constexpr auto operator++() -> IteratorBase& {
+      ++idx_;
+      skipUnset();
+      return *this;
+    }
+
+    constexpr auto operator++(int) -> IteratorBase {
+      const auto pre = *this;
+      ++(*this);
+      return pre;
+    }
+
+    [[nodiscard]] constexpr auto operator==(const IteratorBase& other) const
+        -> bool {
+      return idx_ == other.idx_;
+    }
+
+    friend IteratorBase<!CONST>;
+  };
+
+ public:
+  using iterator       = IteratorBase<false>;
+  using const_iterator = IteratorBase<true>;
+
+  constexpr explicit DenseMap(INDEXER index)
+      : index_{index}, values_(index.size(), UNSET) {}
+
+  constexpr DenseMap(size_t width, size_t height)
+      : DenseMap{INDEXER{width, height}} {}
+
+  template <typename STORE_AS, typename OOB_POLICY, typename LAYOUT>
+  constexpr explicit DenseMap(const Grid<STORE_AS, OOB_POLICY, LAYOUT>& grid)
+      : DenseMap{INDEXER{grid}} {}
+
+  [[nodiscard]] static constexpr auto unset() -> T { return UNSET; }
+
+  constexpr void clear() {
+    std::ranges::fill(values_, UNSET);
+    size_ = 0;
+  }
+
+  [[nodiscard]] constexpr auto find(const KEY& key) -> iterator {
+    return contains(key) ? iterator{this, index_(key)} : end();
+  }
+
+  [[nodiscard]] constexpr auto find(const KEY& key) const -> const_iterator {
+    return contains(key) ? const_iterator{this, index_(key)} : end();
+  }
+
+  [[nodiscard]] constexpr auto contains(const KEY& key) const -> bool {
+    return index_.contains(key) and values_[index_(key)] != UNSET;
+  }
+
+  [[nodiscard]] constexpr auto count(const KEY& key) const -> size_t {
+    return contains(key) ? 1 : 0;
+  }
+
+  [[nodiscard]] constexpr auto at(const KEY& key) -> T& {
+    if (!contains(key)) throw std::out_of_range("DenseMap::at");
+    return values_[index_(key)];
+  }
+
+  [[nodiscard]] constexpr auto at(const KEY& key) const -> const T& {
+    if (!contains(key)) throw std::out_of_range("DenseMap::at");
+    return values_[index_(key)];
+  }
+
+  // Key must be a state of the grid
+  template <typename... ARGS>
+  constexpr auto try_emplace(const KEY& key, ARGS&&... args)  // NOLINT
+      -> std::pair<iterator, bool> {
+    const auto idx = index_(key);
+    if (values_[idx] != UNSET) return {iterator{this, idx}, false};
+    values_[idx] = T(std::forward<ARGS>(args)...);
+    ++size_;
+    return {iterator{this, idx}, true};
+  }
+
+  constexpr auto insert(const value_type& value) -> std::pair<iterator, bool> {
+    return try_emplace(value.first, value.second);
+  }
+
+  constexpr auto insert_or_assign(const KEY& key, T value)  // NOLINT
+      -> std::pair<iterator, bool> {
+    auto [it, inserted] = try_emplace(key, value);
+    if (!inserted) values_[index_(key)] = value;
+    return {it, inserted};
+  }
+
+  // Key must be a state of the grid
+  constexpr auto operator[](const KEY& key) -> T& {
+    try_emplace(key);
+    return values_[index_(key)];
+  }
+
+  constexpr auto erase(const KEY& key) -> size_t {
+    if (!contains(key)) return 0;
+    values_[index_(key)] = UNSET;
+    --size_;
+    return 1;
+  }
+
+  [[nodiscard]] constexpr auto size() const -> size_t { return size_; }
+
+  [[nodiscard]] constexpr auto empty() const -> bool { return size_ == 0; }
+
+  [[nodiscard]] constexpr auto begin() -> iterator {
+    auto it = iterator{this, 0};
+    it.skipUnset();
+    return it;
+  }
+
+  [[nodiscard]] constexpr auto begin() const -> const_iterator {
+    auto it = const_iterator{this, 0};
+    it.skipUnset();
+    return it;
+  }
+
+  [[nodiscard]] constexpr auto end() -> iterator {
+    return {this, values_.size()};
+  }
+
+  [[nodiscard]] constexpr auto end() const -> const_iterator {
+    return {this, values_.size()};
+  }
+};
+
+}  // namespace Utils
+
+#endif  // DENSE_MAP_HH
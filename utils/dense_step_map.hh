@@ -0,0 +1,18 @@
+#ifndef DENSE_STEP_MAP_HH
+#define DENSE_STEP_MAP_HH
+
+#include <limits>
+
+#include "coordinate_step.hh"
+#include "coordinate_step_indexer.hh"
+#include "dense_map.hh"
+
+namespace Utils {
+
+// Drop-in for StepMap when every key is an orthogonal step on one grid
+template <typename T, auto UNSET = std::numeric_limits<T>::max()>
+using DenseStepMap = DenseMap<Step, T, StepIndexer, UNSET>;
+
+}  // namespace Utils
+
+#endif  // DENSE_STEP_MAP_HH
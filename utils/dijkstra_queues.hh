@@ -0,0 +1,149 @@
+#ifndef UTILS_DIJKSTRA_QUEUES_HH
+#define UTILS_DIJKSTRA_QUEUES_HH
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <vector>
+
+#include "weighted_edge.hh"
+
+namespace Utils {
+
+// Queue policies for dijkstra. pop() removes and returns an entry with the
+// smallest distance.
+template <typename QUEUE, typename DISTANCE, typename EDGE>
+concept dijkstra_queue =
+    std::default_initializable<QUEUE> and
+    requires(QUEUE queue, WeightedEdge<DISTANCE, EDGE> entry) {
+      queue.push(entry);
+      { queue.pop() } -> std::same_as<WeightedEdge<DISTANCE, EDGE>>;
+      { queue.empty() } -> std::convertible_to<bool>;
+    };
+
+// Binary heap; works for any ordered DISTANCE
+template <typename DISTANCE, typename EDGE>
+class BinaryHeapQueue {
+  std::priority_queue<WeightedEdge<DISTANCE, EDGE>> heap_{};
+
+ public:
+  void push(const WeightedEdge<DISTANCE, EDGE>& entry) { heap_.push(entry); }
+
+  auto pop() -> WeightedEdge<DISTANCE, EDGE> {
+    const auto top = heap_.top();
+    heap_.pop();
+    return top;
+  }
+
+  [[nodiscard]] auto empty() const -> bool { return heap_.empty(); }
+};
+
+// Dial's circular bucket queue. Queued distances must all lie within
+// MAX_WEIGHT of the smallest one, which holds for dijkstra when no edge weighs
+// more than MAX_WEIGHT.
+template <typename DISTANCE, typename EDGE, DISTANCE MAX_WEIGHT>
+  requires std::integral<DISTANCE>
+class BucketQueue {
+  static constexpr auto BUCKETS = static_cast<size_t>(MAX_WEIGHT) + 1;
+
+  std::vector<std::vector<WeightedEdge<DISTANCE, EDGE>>> buckets_ =
+      std::vector<std::vector<WeightedEdge<DISTANCE, EDGE>>>(BUCKETS);
+  DISTANCE current_{};
+  size_t size_{};
+
+  [[nodiscard]] auto bucketFor(DISTANCE distance)
+      -> std::vector<WeightedEdge<DISTANCE, EDGE>>& {
+    return buckets_[static_cast<size_t>(distance) % BUCKETS];
+  }
+
+ public:
+  void push(const WeightedEdge<DISTANCE, EDGE>& entry) {
+    if (size_++ == 0 or entry.distance < current_) current_ = entry.distance;
+    bucketFor(entry.distance).push_back(entry);
+  }
+
+  auto pop() -> WeightedEdge<DISTANCE, EDGE> {
+    while (bucketFor(current_).empty()) ++current_;
+    auto& bucket    = bucketFor(current_);
+    const auto back = bucket.back();
+    bucket.pop_back();
+    --size_;
+    return back;
+  }
+
+  [[nodiscard]] auto empty() const -> bool { return size_ == 0; }
+};
+
+// Radix heap for monotone integer distances: nothing pushed may be smaller
+// than the last distance popped. Entries move to lower buckets at most once
+// per bit of DISTANCE, so operations are amortized O(1) for fixed-width keys.
+template <typename DISTANCE, typename EDGE>
+  requires std::integral<DISTANCE>
+class RadixHeap {
+  using Key                     = std::make_unsigned_t<DISTANCE>;
+  static constexpr auto BUCKETS = std::numeric_limits<Key>::digits + 1;
+
+  std::array<std::vector<WeightedEdge<DISTANCE, EDGE>>, BUCKETS> buckets_{};
+  Key last_{};
+  size_t size_{};
+
+  // Bucket i holds distances whose highest bit differing from last_ is i - 1
+  [[nodiscard]] auto bucketFor(DISTANCE distance) const -> size_t {
+    return static_cast<size_t>(
+        std::bit_width(static_cast<Key>(static_cast<Key>(distance) ^ last_)));
+  }
+
+ public:
+  void push(const WeightedEdge<DISTANCE, EDGE>& entry) {
+    buckets_[bucketFor(entry.distance)].push_back(entry);
+    ++size_;
+  }
+
+  auto pop() -> WeightedEdge<DISTANCE, EDGE> {
+    if (buckets_[0].empty()) {
+      // Every entry of the first non-empty bucket lands in a lower bucket
+      // once last_ moves up to the smallest of them
+      auto& lowest = *std::ranges::find_if(
+          buckets_, [](const auto& bucket) { return !bucket.empty(); });
+      last_ = static_cast<Key>(
+          std::ranges::min(lowest, {}, &WeightedEdge<DISTANCE, EDGE>::distance)
+              .distance);
+      for (const auto& entry : lowest)
+        buckets_[bucketFor(entry.distance)].push_back(entry);
+      lowest.clear();
+    }
+
+    const auto back = buckets_[0].back();
+    buckets_[0].pop_back();
+    --size_;
+    return back;
+  }
+
+  [[nodiscard]] auto empty() const -> bool { return size_ == 0; }
+};
+
+namespace Detail {
+
+template <typename DISTANCE, typename EDGE>
+struct default_queue {
+  using type = BinaryHeapQueue<DISTANCE, EDGE>;
+};
+
+template <std::integral DISTANCE, typename EDGE>
+struct default_queue<DISTANCE, EDGE> {
+  using type = RadixHeap<DISTANCE, EDGE>;
+};
+
+}  // namespace Detail
+
+// Integral distances (all of this repository's searches) use a radix heap
+template <typename DISTANCE, typename EDGE>
+using DefaultQueue = typename Detail::default_queue<DISTANCE, EDGE>::type;
+
+}  // namespace Utils
+
+#endif  // UTILS_DIJKSTRA_QUEUES_HH
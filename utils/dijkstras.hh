@@ -1,89 +1,401 @@
 #ifndef UTILS_DIJKSTRAS_HH
 #define UTILS_DIJKSTRAS_HH
 
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
-#include <queue>
-#include <unordered_map>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "dijkstra_queues.hh"
+#include "flat_map.hh"
+#include "weighted_edge.hh"
 
 namespace Utils::Detail {
 
 template <typename KEY, typename VALUE>
-struct default_map : std::unordered_map<KEY, VALUE> {
+struct default_map : FlatMap<KEY, VALUE> {
   static inline VALUE max_ = std::numeric_limits<VALUE>::max();
-  [[nodiscard]] constexpr auto at_or_max(const KEY& key) const -> const VALUE& {
-    if (this->contains(key)) return this->at(key);
-    return max_;
+  [[nodiscard]] auto at_or_max(const KEY& key) const -> const VALUE& {
+    const auto it = this->find(key);
+    return it == this->end() ? max_ : it->second;
   }
 };
 
+// Adjacency is either a range of WeightedEdges returned by adjacent(from), or
+// a visitor protocol, adjacent(from, visit), calling visit(WeightedEdge) for
+// every edge. Visitors (or fixed capacity ranges such as InplaceVector) keep
+// the search loop free of allocations.
+template <typename ADJACENT, typename EDGE, typename VISITOR>
+void forEachAdjacent(ADJACENT&& adjacent, const EDGE& from, VISITOR&& visit) {
+  if constexpr (std::invocable<ADJACENT&, const EDGE&, VISITOR&>) {
+    adjacent(from, visit);
+  } else {
+    for (const auto& edge : adjacent(from)) visit(edge);
+  }
+}
+
 }  // namespace Utils::Detail
 
 namespace Utils {
 
-template <typename DISTANCE, typename EDGE>
-struct WeightedEdge {
-  DISTANCE distance;
-  EDGE edge;
-
-  [[nodiscard]] constexpr auto operator<(const WeightedEdge& other) const
-      -> bool {
-    // NOTE(AE): REVERSE ORDERING - MIN ELEMENT FIRST
-    return other.distance < distance;
-  }
-};
-
-template <typename DISTANCE, typename EDGE>
+template <typename DISTANCE, typename EDGE,
+          dijkstra_queue<DISTANCE, EDGE> QUEUE = DefaultQueue<DISTANCE, EDGE>>
 [[nodiscard]] auto dijkstra(WeightedEdge<DISTANCE, EDGE> start,
                             auto&& adjacent) {
   auto distances = Detail::default_map<EDGE, DISTANCE>{};
-  auto previous  = std::unordered_map<EDGE, std::unordered_set<EDGE>>{};
+  auto previous  = FlatMap<EDGE, std::unordered_set<EDGE>>{};
 
-  auto queue = std::priority_queue<WeightedEdge<DISTANCE, EDGE>>{};
+  auto queue = QUEUE{};
   queue.push(start);
 
   while (!queue.empty()) {
-    const auto [distance, current] = queue.top();
-    queue.pop();
+    const auto [distance, current] = queue.pop();
 
-    for (const auto [distance_to, other] : adjacent(current)) {
+    Detail::forEachAdjacent(adjacent, current, [&](const auto& adjacent_edge) {
+      const auto [distance_to, other] = adjacent_edge;
       if (distance + distance_to < distances.at_or_max(other)) {
         distances[other] = distance + distance_to;
         queue.push({distances[other], other});
       }
       if (distance + distance_to <= distances.at_or_max(other))
         previous[other].insert(current);
-    }
+    });
   }
 
   return std::make_pair(distances, previous);
 }
 
-template <typename DISTANCE, typename EDGE>
+template <typename DISTANCE, typename EDGE,
+          dijkstra_queue<DISTANCE, EDGE> QUEUE = DefaultQueue<DISTANCE, EDGE>>
 [[nodiscard]] auto dijkstra(WeightedEdge<DISTANCE, EDGE> start, EDGE finish,
                             auto&& adjacent) {
   auto distances = Detail::default_map<EDGE, DISTANCE>{};
 
-  auto queue = std::priority_queue<WeightedEdge<DISTANCE, EDGE>>{};
+  auto queue = QUEUE{};
   queue.push(start);
 
   while (!queue.empty()) {
-    const auto [distance, current] = queue.top();
-    queue.pop();
+    const auto [distance, current] = queue.pop();
 
     if (current == finish) return distance;
 
-    for (const auto [distance_to, other] : adjacent(current)) {
+    Detail::forEachAdjacent(adjacent, current, [&](const auto& adjacent_edge) {
+      const auto [distance_to, other] = adjacent_edge;
       if (distance + distance_to < distances.at_or_max(other)) {
         distances[other] = distance + distance_to;
         queue.push({distances[other], other});
       }
-    }
+    });
   }
 
   return DISTANCE{};
 }
 
+// Maps every state of a search onto [0, size()) and back, so that the search
+// can keep its bookkeeping in flat arrays
+template <typename INDEXER, typename EDGE>
+concept state_indexer =
+    requires(const INDEXER& indexer, const EDGE& edge, size_t idx) {
+      { indexer(edge) } -> std::convertible_to<size_t>;
+      { indexer.stateAt(idx) } -> std::convertible_to<EDGE>;
+      { indexer.size() } -> std::convertible_to<size_t>;
+    };
+
+// Distances from the start of a dense search, along with a DAG of the
+// predecessors of every state on any shortest path to it. The DAG is kept in
+// compressed sparse row form: the predecessors of state i are
+// sources_[offsets_[i] .. offsets_[i + 1]). States are indexed with 32 bits.
+template <typename DISTANCE, typename EDGE, state_indexer<EDGE> INDEXER>
+class ShortestPaths {
+  struct Arc {
+    uint32_t from;
+    uint32_t to;
+    DISTANCE distance;
+  };
+
+  INDEXER index_;
+  std::vector<DISTANCE> distances_;
+  std::vector<Arc> arcs_{};  // Candidates, until link()
+  std::vector<uint32_t> offsets_{};
+  std::vector<uint32_t> sources_{};
+
+  [[nodiscard]] auto predecessorsOf(size_t idx) const {
+    return std::span{sources_}.subspan(offsets_[idx],
+                                       offsets_[idx + 1] - offsets_[idx]);
+  }
+
+ public:
+  explicit ShortestPaths(const INDEXER& index)
+      : index_{index},
+        distances_(index.size(), std::numeric_limits<DISTANCE>::max()) {}
+
+  void start(size_t idx, DISTANCE distance) { distances_[idx] = distance; }
+
+  // Records the edge from -> to; true if it shortened the path to `to`
+  auto relax(size_t from, size_t to, DISTANCE distance) -> bool {
+    if (distances_[to] < distance) return false;
+    arcs_.push_back({.from     = static_cast<uint32_t>(from),
+                     .to       = static_cast<uint32_t>(to),
+                     .distance = distance});
+    if (distances_[to] == distance) return false;
+    distances_[to] = distance;
+    return true;
+  }
+
+  // Called once the search is done; builds the DAG from the arcs that still
+  // lie on a shortest path, in two linear passes
+  void link() {
+    const auto tight = [&](const Arc& arc) {
+      return arc.distance == distances_[arc.to];
+    };
+
+    offsets_.assign(distances_.size() + 1, 0);
+    for (const auto& arc : arcs_)
+      if (tight(arc)) ++offsets_[arc.to + 1];
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+
+    sources_.resize(offsets_.back());
+    auto next = std::vector<uint32_t>(offsets_.begin(), offsets_.end() - 1);
+    for (const auto& arc : arcs_)
+      if (tight(arc)) sources_[next[arc.to]++] = arc.from;
+    arcs_ = {};
+  }
+
+  [[nodiscard]] auto distance(const EDGE& state) const -> DISTANCE {
+    return distances_[index_(state)];
+  }
+
+  [[nodiscard]] auto reached(const EDGE& state) const -> bool {
+    return distance(state) != std::numeric_limits<DISTANCE>::max();
+  }
+
+  [[nodiscard]] auto previous(const EDGE& state) const {
+    return predecessorsOf(index_(state)) |
+           std::views::transform(
+               [this](uint32_t idx) { return index_.stateAt(idx); });
+  }
+
+  [[nodiscard]] auto distanceAt(size_t idx) const -> DISTANCE {
+    return distances_[idx];
+  }
+
+  // Every state on any shortest path to one of the targets (targets
+  // included), visiting each state and DAG edge once
+  [[nodiscard]] auto onShortestPaths(std::ranges::input_range auto&& targets)
+      const -> std::vector<EDGE> {
+    auto seen  = std::vector<bool>(distances_.size());
+    auto stack = std::vector<size_t>{};
+    const auto visit = [&](size_t idx) {
+      if (seen[idx]) return;
+      seen[idx] = true;
+      stack.push_back(idx);
+    };
+
+    for (const auto& target : targets)
+      if (reached(target)) visit(index_(target));
+
+    auto states = std::vector<EDGE>{};
+    while (!stack.empty()) {
+      const auto idx = stack.back();
+      stack.pop_back();
+      states.push_back(index_.stateAt(idx));
+      for (const auto from : predecessorsOf(idx)) visit(from);
+    }
+    return states;
+  }
+};
+
+// Dense variants; states are indexed, settled states are never expanded twice
+// and stale queue entries are skipped
+
+template <typename DISTANCE, typename EDGE,
+          dijkstra_queue<DISTANCE, EDGE> QUEUE = DefaultQueue<DISTANCE, EDGE>,
+          state_indexer<EDGE> INDEXER>
+[[nodiscard]] auto dijkstra(WeightedEdge<DISTANCE, EDGE> start,
+                            auto&& adjacent, const INDEXER& index)
+    -> ShortestPaths<DISTANCE, EDGE, INDEXER> {
+  auto paths   = ShortestPaths<DISTANCE, EDGE, INDEXER>{index};
+  auto settled = std::vector<bool>(index.size());
+
+  auto queue = QUEUE{};
+  paths.start(index(start.edge), start.distance);
+  queue.push(start);
+
+  while (!queue.empty()) {
+    const auto [distance, current] = queue.pop();
+
+    const auto from = index(current);
+    if (settled[from]) continue;
+    settled[from] = true;
+
+    Detail::forEachAdjacent(adjacent, current, [&](const auto& adjacent_edge) {
+      const auto [distance_to, other] = adjacent_edge;
+      if (paths.relax(from, index(other), distance + distance_to))
+        queue.push({distance + distance_to, other});
+    });
+  }
+
+  paths.link();
+  return paths;
+}
+
+template <typename DISTANCE>
+struct SearchResult {
+  DISTANCE distance;  // DISTANCE{} when the finish cannot be reached
+  size_t expanded;    // Number of states settled and expanded
+};
+
+// A* search. The heuristic (EDGE -> DISTANCE) must be consistent: it never
+// decreases by more than the weight of an edge, and is zero at the finish.
+// Manhattan distance on a grid with unit steps is one such heuristic.
+template <typename DISTANCE, typename EDGE,
+          dijkstra_queue<DISTANCE, EDGE> QUEUE = DefaultQueue<DISTANCE, EDGE>,
+          state_indexer<EDGE> INDEXER>
+[[nodiscard]] auto aStar(WeightedEdge<DISTANCE, EDGE> start, EDGE finish,
+                         auto&& adjacent, const INDEXER& index,
+                         auto&& heuristic) -> SearchResult<DISTANCE> {
+  auto distances =
+      std::vector<DISTANCE>(index.size(), std::numeric_limits<DISTANCE>::max());
+  auto settled  = std::vector<bool>(index.size());
+  auto expanded = size_t{};
+
+  // Queued by distance so far plus the heuristic's estimate of the rest
+  auto queue = QUEUE{};
+  distances[index(start.edge)] = start.distance;
+  queue.push({start.distance + heuristic(start.edge), start.edge});
+
+  while (!queue.empty()) {
+    const auto current = queue.pop().edge;
+    const auto from    = index(current);
+
+    if (current == finish) return {distances[from], expanded};
+
+    if (settled[from]) continue;
+    settled[from] = true;
+    ++expanded;
+
+    const auto distance = distances[from];
+    Detail::forEachAdjacent(adjacent, current, [&](const auto& adjacent_edge) {
+      const auto [distance_to, other] = adjacent_edge;
+      auto& best = distances[index(other)];
+      if (distance + distance_to < best) {
+        best = distance + distance_to;
+        queue.push({best + heuristic(other), other});
+      }
+    });
+  }
+
+  return {DISTANCE{}, expanded};
+}
+
+template <typename DISTANCE, typename EDGE,
+          dijkstra_queue<DISTANCE, EDGE> QUEUE = DefaultQueue<DISTANCE, EDGE>,
+          state_indexer<EDGE> INDEXER>
+[[nodiscard]] auto dijkstra(WeightedEdge<DISTANCE, EDGE> start, EDGE finish,
+                            auto&& adjacent, const INDEXER& index) -> DISTANCE {
+  const auto no_estimate = [](const EDGE& /*unused*/) { return DISTANCE{}; };
+  return aStar<DISTANCE, EDGE, QUEUE>(start, finish, adjacent, index,
+                                      no_estimate)
+      .distance;
+}
+
+namespace Detail {
+
+// One direction of a bidirectional search
+template <typename DISTANCE, typename EDGE, typename QUEUE>
+struct SearchFront {
+  std::vector<DISTANCE> distances;
+  std::vector<bool> settled;
+  QUEUE queue{};
+  std::optional<WeightedEdge<DISTANCE, EDGE>> next{};
+
+  explicit SearchFront(size_t states)
+      : distances(states, std::numeric_limits<DISTANCE>::max()),
+        settled(states) {}
+
+  // Smallest queued entry that is not stale, if any
+  auto peek(const auto& index) -> std::optional<WeightedEdge<DISTANCE, EDGE>>& {
+    while (!next and !queue.empty()) {
+      const auto entry = queue.pop();
+      if (!settled[index(entry.edge)]) next = entry;
+    }
+    return next;
+  }
+};
+
+}  // namespace Detail
+
+// Bidirectional dijkstra; searches forward from start and backward from
+// finish until the fronts meet. reverse_adjacent(to) lists the edges ending
+// at `to`, each as {distance, from}. Stops once the two smallest queued
+// distances add up to at least the best path seen, which makes that path a
+// shortest one.
+template <typename DISTANCE, typename EDGE,
+          dijkstra_queue<DISTANCE, EDGE> QUEUE = DefaultQueue<DISTANCE, EDGE>,
+          state_indexer<EDGE> INDEXER>
+[[nodiscard]] auto bidirectionalDijkstra(WeightedEdge<DISTANCE, EDGE> start,
+                                         EDGE finish, auto&& adjacent,
+                                         auto&& reverse_adjacent,
+                                         const INDEXER& index)
+    -> SearchResult<DISTANCE> {
+  using Front                  = Detail::SearchFront<DISTANCE, EDGE, QUEUE>;
+  static constexpr auto NO_PATH = std::numeric_limits<DISTANCE>::max();
+
+  auto forward  = Front{index.size()};
+  auto backward = Front{index.size()};
+  auto best     = start.edge == finish ? start.distance : NO_PATH;
+  auto expanded = size_t{};
+
+  forward.distances[index(start.edge)] = start.distance;
+  forward.queue.push(start);
+  backward.distances[index(finish)] = DISTANCE{};
+  backward.queue.push({DISTANCE{}, finish});
+
+  const auto expand = [&](Front& front, const Front& other, auto&& edges,
+                          const EDGE& current) {
+    const auto from = index(current);
+    front.settled[from] = true;
+    ++expanded;
+
+    const auto distance = front.distances[from];
+    Detail::forEachAdjacent(edges, current, [&](const auto& adjacent_edge) {
+      const auto [distance_to, next] = adjacent_edge;
+      const auto to = index(next);
+      if (distance + distance_to < front.distances[to]) {
+        front.distances[to] = distance + distance_to;
+        front.queue.push({front.distances[to], next});
+      }
+      if (other.distances[to] != NO_PATH)
+        best = std::min(best, distance + distance_to + other.distances[to]);
+    });
+  };
+
+  while (true) {
+    const auto& ahead  = forward.peek(index);
+    const auto& behind = backward.peek(index);
+    if (!ahead or !behind) break;
+    if (best != NO_PATH and ahead->distance + behind->distance >= best) break;
+
+    if (ahead->distance <= behind->distance) {
+      const auto current = std::exchange(forward.next, std::nullopt)->edge;
+      expand(forward, backward, adjacent, current);
+    } else {
+      const auto current = std::exchange(backward.next, std::nullopt)->edge;
+      expand(backward, forward, reverse_adjacent, current);
+    }
+  }
+
+  return {best == NO_PATH ? DISTANCE{} : best, expanded};
+}
+
 }  // namespace Utils
 
 #endif  // UTILS_DIJKSTRAS_HH
@@ -0,0 +1,399 @@
+#ifndef UTILS_FLAT_MAP_HH
+#define UTILS_FLAT_MAP_HH
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Utils {
+
+// Finalizer from MurmurHash3; every input bit affects every output bit
+[[nodiscard]] constexpr auto mixHash(uint64_t value) -> uint64_t {
+  value ^= value >> 33U;
+  value *= 0xff51afd7ed558ccdULL;
+  value ^= value >> 33U;
+  value *= 0xc4ceb9fe1a85ec53ULL;
+  value ^= value >> 33U;
+  return value;
+}
+
+namespace Detail {
+
+// Hashers that already mix their output declare `using is_avalanching = void`;
+// all others (std::hash<int> is the identity) get mixed by the map
+template <typename HASH>
+concept avalanching_hash = requires { typename HASH::is_avalanching; };
+
+// Control bytes of a FlatMap, scanned a group of eight at a time. Full slots
+// hold the low 7 bits of their hash, so the high bit marks free slots.
+namespace Control {
+
+inline constexpr uint8_t EMPTY   = 0b1000'0000;
+inline constexpr uint8_t DELETED = 0b1111'1110;
+
+inline constexpr size_t GROUP_WIDTH = 8;
+inline constexpr uint64_t LSBS      = 0x0101'0101'0101'0101ULL;
+inline constexpr uint64_t MSBS      = 0x8080'8080'8080'8080ULL;
+
+[[nodiscard]] inline auto loadGroup(const uint8_t* group) -> uint64_t {
+  auto word = uint64_t{};
+  std::memcpy(&word, group, sizeof(word));
+  return word;
+}
+
+// May report false positives (which fail the key comparison), never misses
+[[nodiscard]] constexpr auto matching(uint64_t group, uint8_t tag)
+    -> uint64_t {
+  const auto bytes = group ^ (LSBS * tag);
+  return (bytes - LSBS) & ~bytes & MSBS;
+}
+
+[[nodiscard]] constexpr auto empty(uint64_t group) -> uint64_t {
+  return group & ~(group << 6U) & MSBS;
+}
+
+[[nodiscard]] constexpr auto available(uint64_t group) -> uint64_t {
+  return group & ~(group << 7U) & MSBS;
+}
+
+[[nodiscard]] constexpr auto firstIndex(uint64_t mask) -> size_t {
+  return static_cast<size_t>(std::countr_zero(mask)) / 8;
+}
+
+}  // namespace Control
+
+}  // namespace Detail
+
+// Open addressing hash map storing its elements inline (in the manner of
+// Swiss tables). Probes groups of eight control bytes at once, so lookups
+// rarely touch more than one cache line of metadata. Iterators and references
+// are invalidated by any insertion that grows the table.
+template <typename KEY, typename VALUE, typename HASH = std::hash<KEY>,
+          typename EQUAL = std::equal_to<KEY>>
+class FlatMap {
+ public:
+  using key_type    = KEY;
+  using mapped_type = VALUE;
+  using value_type  = std::pair<const KEY, VALUE>;
+
+ private:
+  union Slot {
+    value_type value;
+
+    Slot() {}   // NOLINT
+    ~Slot() {}  // NOLINT
+  };
+
+  std::vector<uint8_t> control_{};
+  std::unique_ptr<Slot[]> slots_{};  // NOLINT
+  size_t capacity_{};
+  size_t size_{};
+  size_t growth_left_{};
+
+  [[no_unique_address]] HASH hash_{};
+  [[no_unique_address]] EQUAL equal_{};
+
+  [[nodiscard]] auto hashOf(const KEY& key) const -> uint64_t {
+    const auto hash = static_cast<uint64_t>(hash_(key));
+    if constexpr (Detail::avalanching_hash<HASH>) {
+      return hash;
+    } else {
+      return mixHash(hash);
+    }
+  }
+
+  [[nodiscard]] static constexpr auto tagOf(uint64_t hash) -> uint8_t {
+    return static_cast<uint8_t>(hash & 0x7FU);
+  }
+
+  // Triangular probing over groups; visits every group once when the number
+  // of groups is a power of two
+  class Probe {
+    size_t mask_;
+    size_t group_;
+    size_t step_{};
+
+   public:
+    Probe(uint64_t hash, size_t groups)
+        : mask_{groups - 1}, group_{static_cast<size_t>(hash >> 7U) & mask_} {}
+
+    [[nodiscard]] auto offset() const -> size_t {
+      return group_ * Detail::Control::GROUP_WIDTH;
+    }
+
+    void next() { group_ = (group_ + ++step_) & mask_; }
+  };
+
+  [[nodiscard]] auto groups() const -> size_t {
+    return capacity_ / Detail::Control::GROUP_WIDTH;
+  }
+
+  [[nodiscard]] auto groupAt(size_t offset) const -> uint64_t {
+    return Detail::Control::loadGroup(control_.data() + offset);
+  }
+
+  [[nodiscard]] auto slotOf(const KEY& key, uint64_t hash) const -> size_t {
+    if (capacity_ == 0) return capacity_;
+    for (auto probe = Probe{hash, groups()};; probe.next()) {
+      const auto group = groupAt(probe.offset());
+      for (auto match = Detail::Control::matching(group, tagOf(hash));
+           match != 0; match &= match - 1) {
+        const auto idx = probe.offset() + Detail::Control::firstIndex(match);
+        if (equal_(slots_[idx].value.first, key)) return idx;
+      }
+      if (Detail::Control::empty(group) != 0) return capacity_;
+    }
+  }
+
+  [[nodiscard]] auto freeSlotFor(uint64_t hash) const -> size_t {
+    for (auto probe = Probe{hash, groups()};; probe.next()) {
+      const auto available =
+          Detail::Control::available(groupAt(probe.offset()));
+      if (available != 0)
+        return probe.offset() + Detail::Control::firstIndex(available);
+    }
+  }
+
+  void rehash(size_t capacity) {
+    auto old_control = std::exchange(control_, {});
+    auto old_slots   = std::exchange(slots_, {});
+    const auto old   = std::exchange(capacity_, capacity);
+
+    control_.assign(capacity_, Detail::Control::EMPTY);
+    slots_       = std::make_unique<Slot[]>(capacity_);  // NOLINT
+    growth_left_ = capacity_ - capacity_ / 8 - size_;
+
+    for (size_t idx = 0; idx != old; ++idx) {
+      if (old_control[idx] >= Detail::Control::EMPTY) continue;
+      auto& value     = old_slots[idx].value;
+      const auto hash = hashOf(value.first);
+      const auto to   = freeSlotFor(hash);
+      control_[to]    = tagOf(hash);
+      std::construct_at(&slots_[to].value, std::move(value));
+      std::destroy_at(&value);
+    }
+  }
+
+  // Grows once the table is 7/8 full (tombstones included); a table mostly
+  // full of tombstones is rebuilt at the same size instead
+  void reserveOne() {
+    if (growth_left_ != 0) return;
+    const auto capacity = capacity_ == 0 ? 2 * Detail::Control::GROUP_WIDTH
+                          : size_ * 2 >= capacity_ - capacity_ / 8
+                              ? capacity_ * 2
+                              : capacity_;
+    rehash(capacity);
+  }
+
+  template <bool CONST>
+  class IteratorBase {
+    using Map = std::conditional_t<CONST, const FlatMap, FlatMap>;
+    Map* map_p_{nullptr};
+    size_t idx_{};
+
+    friend FlatMap;
+    IteratorBase(Map* map, size_t idx) : map_p_{map}, idx_{idx} {}
+
+    void skipFree() {
+      while (idx_ != map_p_->capacity_ and
+             map_p_->control_[idx_] >= Detail::Control::EMPTY)
+        ++idx_;
+    }
+
+   public:
+    using iterator_concept = std::forward_iterator_tag;
+    using difference_type  = std::ptrdiff_t;
+    using value_type       = FlatMap::value_type;
+    using reference = std::conditional_t<CONST, const value_type&, value_type&>;
+
+    IteratorBase() = default;
+
+    // const_iterator from iterator
+    template <bool OTHER>
+      requires(CONST and !OTHER)
+    IteratorBase(const IteratorBase<OTHER>& other)  // NOLINT
+        : map_p_{other.map_p_}, idx_{other.idx_} {}
+
+    [[nodiscard]] auto operator*() const -> reference {
+      return map_p_->slots_[idx_].value;
+    }
+
+    [[nodiscard]] auto operator->() const { return &**this; }
+
+    auto operator++() -> IteratorBase& {
+      ++idx_;
+      skipFree();
+      return *this;
+    }
+
+    auto operator++(int) -> IteratorBase {
+      const auto pre = *this;
+      ++(*this);
+      return pre;
+    }
+
+    [[nodiscard]] auto operator==(const IteratorBase& other) const -> bool {
+      return idx_ == other.idx_;
+    }
+
+    friend IteratorBase<!CONST>;
+  };
+
+ public:
+  using iterator       = IteratorBase<false>;
+  using const_iterator = IteratorBase<true>;
+
+  FlatMap() = default;
+
+  FlatMap(const FlatMap& other) : hash_{other.hash_}, equal_{other.equal_} {
+    reserve(other.size());
+    for (const auto& value : other) insert(value);
+  }
+
+  FlatMap(FlatMap&& other) noexcept
+      : control_{std::move(other.control_)},
+        slots_{std::move(other.slots_)},
+        capacity_{std::exchange(other.capacity_, 0)},
+        size_{std::exchange(other.size_, 0)},
+        growth_left_{std::exchange(other.growth_left_, 0)},
+        hash_{std::move(other.hash_)},
+        equal_{std::move(other.equal_)} {}
+
+  auto operator=(FlatMap other) noexcept -> FlatMap& {
+    swap(other);
+    return *this;
+  }
+
+  ~FlatMap() { clear(); }
+
+  void swap(FlatMap& other) noexcept {
+    std::swap(control_, other.control_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+  }
+
+  void reserve(size_t count) {
+    auto capacity = std::max(capacity_, 2 * Detail::Control::GROUP_WIDTH);
+    while (count > capacity - capacity / 8) capacity *= 2;
+    if (capacity != capacity_) rehash(capacity);
+  }
+
+  void clear() {
+    for (size_t idx = 0; idx != capacity_; ++idx) {
+      if (control_[idx] >= Detail::Control::EMPTY) continue;
+      std::destroy_at(&slots_[idx].value);
+    }
+    std::ranges::fill(control_, Detail::Control::EMPTY);
+    size_        = 0;
+    growth_left_ = capacity_ - capacity_ / 8;
+  }
+
+  [[nodiscard]] auto find(const KEY& key) -> iterator {
+    return {this, slotOf(key, hashOf(key))};
+  }
+
+  [[nodiscard]] auto find(const KEY& key) const -> const_iterator {
+    return {this, slotOf(key, hashOf(key))};
+  }
+
+  [[nodiscard]] auto contains(const KEY& key) const -> bool {
+    return find(key) != end();
+  }
+
+  [[nodiscard]] auto count(const KEY& key) const -> size_t {
+    return contains(key) ? 1 : 0;
+  }
+
+  [[nodiscard]] auto at(const KEY& key) -> VALUE& {
+    const auto it = find(key);
+    if (it == end()) throw std::out_of_range("FlatMap::at");
+    return it->second;
+  }
+
+  [[nodiscard]] auto at(const KEY& key) const -> const VALUE& {
+    const auto it = find(key);
+    if (it == end()) throw std::out_of_range("FlatMap::at");
+    return it->second;
+  }
+
+  template <typename... ARGS>
+  auto try_emplace(const KEY& key, ARGS&&... args)  // NOLINT
+      -> std::pair<iterator, bool> {
+    const auto hash = hashOf(key);
+    if (const auto idx = slotOf(key, hash); idx != capacity_)
+      return {iterator{this, idx}, false};
+
+    reserveOne();
+    const auto idx = freeSlotFor(hash);
+    if (control_[idx] == Detail::Control::EMPTY) --growth_left_;
+    control_[idx] = tagOf(hash);
+    std::construct_at(&slots_[idx].value, std::piecewise_construct,
+                      std::forward_as_tuple(key),
+                      std::forward_as_tuple(std::forward<ARGS>(args)...));
+    ++size_;
+    return {iterator{this, idx}, true};
+  }
+
+  auto insert(const value_type& value) -> std::pair<iterator, bool> {
+    return try_emplace(value.first, value.second);
+  }
+
+  auto insert_or_assign(const KEY& key, VALUE value)  // NOLINT
+      -> std::pair<iterator, bool> {
+    auto [it, inserted] = try_emplace(key, std::move(value));
+    if (!inserted) it->second = std::move(value);
+    return {it, inserted};
+  }
+
+  auto operator[](const KEY& key) -> VALUE& {
+    return try_emplace(key).first->second;
+  }
+
+  auto erase(const KEY& key) -> size_t {
+    const auto idx = slotOf(key, hashOf(key));
+    if (idx == capacity_) return 0;
+    std::destroy_at(&slots_[idx].value);
+    control_[idx] = Detail::Control::DELETED;
+    --size_;
+    return 1;
+  }
+
+  [[nodiscard]] auto size() const -> size_t { return size_; }
+
+  [[nodiscard]] auto empty() const -> bool { return size_ == 0; }
+
+  [[nodiscard]] auto begin() -> iterator {
+    auto it = iterator{this, 0};
+    if (capacity_ != 0) it.skipFree();
+    return it;
+  }
+
+  [[nodiscard]] auto begin() const -> const_iterator {
+    auto it = const_iterator{this, 0};
+    if (capacity_ != 0) it.skipFree();
+    return it;
+  }
+
+  [[nodiscard]] auto end() -> iterator { return {this, capacity_}; }
+
+  [[nodiscard]] auto end() const -> const_iterator {
+    return {this, capacity_};
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_FLAT_MAP_HH
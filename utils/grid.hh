@@ -4,14 +4,24 @@
 // Original by Sy Brand
 // --> https://github.com/TartanLlama/aoc-2024/blob/main/src/grid.hpp
 
+#include <algorithm>
+#include <bit>
 #include <cmath>
 #include <istream>
 #include <optional>
 #include <ranges>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "coordinate.hh"
+#include "line_index.hh"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 namespace Utils::OutOfBoundsPolicy {
 
@@ -28,6 +38,17 @@ struct Undefined {
   static constexpr auto check_bounds = false;
 };
 
+// Like Default without the bounds check: the grid is stored inside a frame of
+// BORDER cells holding DEFAULT_VALUE, so reading up to BORDER cells outside
+// the grid finds it. Reading further out is undefined, and the frame must not
+// be written to.
+template <auto DEFAULT_VALUE, size_t BORDER = 1>
+struct Halo {
+  static constexpr auto check_bounds  = false;
+  static constexpr auto border        = BORDER;
+  static constexpr auto default_value = DEFAULT_VALUE;
+};
+
 struct Throw {
   static constexpr auto check_bounds = true;
   static void outOfBounds() {
@@ -49,35 +70,197 @@ struct fromAscii {
 
 }  // namespace Utils::CharConverter
 
+namespace Utils::Layout {
+
+// A layout maps the cells of a width x height area onto storage offsets;
+// size() is the number of cells it stores.
+
+struct RowMajor {
+  static constexpr auto contiguous_rows = true;
+
+  size_t width{};
+  size_t height{};
+
+  [[nodiscard]] constexpr auto size() const -> size_t {
+    return width * height;
+  }
+
+  [[nodiscard]] constexpr auto operator()(size_t x, size_t y) const
+      -> size_t {
+    return y * width + x;
+  }
+};
+
+// Square tiles of TILE x TILE cells, each stored row major, with the tiles
+// in row major order. Cells above and below each other share a tile, and
+// mostly a cache line.
+template <size_t TILE>
+  requires(std::has_single_bit(TILE))
+struct Tiled {
+  static constexpr auto contiguous_rows = false;
+
+  size_t width{};
+  size_t height{};
+
+  [[nodiscard]] constexpr auto tilesAcross() const -> size_t {
+    return (width + TILE - 1) / TILE;
+  }
+
+  [[nodiscard]] constexpr auto size() const -> size_t {
+    return tilesAcross() * ((height + TILE - 1) / TILE) * TILE * TILE;
+  }
+
+  [[nodiscard]] constexpr auto operator()(size_t x, size_t y) const
+      -> size_t {
+    return ((y / TILE) * tilesAcross() + x / TILE) * TILE * TILE +
+           (y % TILE) * TILE + x % TILE;
+  }
+};
+
+// Z-order: the offset interleaves the bits of x (even) and y (odd), using
+// BMI2's pdep when the build targets it (-mbmi2 or -march), and shifts and
+// masks otherwise. Stores the enclosing power of two square.
+struct Morton {
+  static constexpr auto contiguous_rows = false;
+#if defined(__BMI2__)
+  static constexpr auto uses_pdep = true;
+#else
+  static constexpr auto uses_pdep = false;
+#endif
+
+  size_t width{};
+  size_t height{};
+
+  [[nodiscard]] static constexpr auto spread(size_t value) -> size_t {
+#if defined(__BMI2__)
+    if !consteval {
+      return _pdep_u64(value, 0x5555'5555'5555'5555ULL);
+    }
+#endif
+    value &= 0xFFFF'FFFFULL;
+    value = (value | (value << 16U)) & 0x0000'FFFF'0000'FFFFULL;
+    value = (value | (value << 8U)) & 0x00FF'00FF'00FF'00FFULL;
+    value = (value | (value << 4U)) & 0x0F0F'0F0F'0F0F'0F0FULL;
+    value = (value | (value << 2U)) & 0x3333'3333'3333'3333ULL;
+    value = (value | (value << 1U)) & 0x5555'5555'5555'5555ULL;
+    return value;
+  }
+
+  [[nodiscard]] constexpr auto size() const -> size_t {
+    const auto side = std::bit_ceil(std::max(width, height));
+    return side * side;
+  }
+
+  [[nodiscard]] constexpr auto operator()(size_t x, size_t y) const
+      -> size_t {
+    return spread(x) | (spread(y) << 1U);
+  }
+};
+
+}  // namespace Utils::Layout
+
 namespace Utils {
 
-template <typename STORE_AS, typename OOB_POLICY = OutOfBoundsPolicy::Undefined>
+template <typename STORE_AS, typename OOB_POLICY = OutOfBoundsPolicy::Undefined,
+          typename LAYOUT = Layout::RowMajor>
 class Grid {
+  static constexpr auto BORDER = [] {
+    if constexpr (requires { OOB_POLICY::border; })
+      return size_t{OOB_POLICY::border};
+    else
+      return size_t{};
+  }();
+
   size_t width_{};
   size_t height_{};
+  LAYOUT layout_{};  // Over the grid and its frame
   std::vector<STORE_AS> data_{};
 
+  // Cells within the frame wrap around through size_t, on purpose
+  [[nodiscard]] constexpr auto offsetOf(size_t x, size_t y) const -> size_t {
+    return layout_(x + BORDER, y + BORDER);
+  }
+
+  [[nodiscard]] constexpr auto offsetOf(Coordinate coordinate) const
+      -> size_t {
+    return offsetOf(static_cast<size_t>(coordinate.x),
+                    static_cast<size_t>(coordinate.y));
+  }
+
+  // Stores row major cells (width_ * height_ of them) in the layout, inside
+  // the frame
+  void place(std::vector<STORE_AS> cells) {
+    layout_ = LAYOUT{width_ + 2 * BORDER, height_ + 2 * BORDER};
+    if constexpr (BORDER == 0 and LAYOUT::contiguous_rows) {
+      data_ = std::move(cells);
+    } else {
+      if constexpr (BORDER == 0) {
+        data_.assign(layout_.size(), STORE_AS{});
+      } else {
+        data_.assign(layout_.size(), OOB_POLICY::default_value);
+      }
+      for (size_t y = 0; y != height_; ++y)
+        for (size_t x = 0; x != width_; ++x)
+          data_[offsetOf(x, y)] = std::move(cells[y * width_ + x]);
+    }
+  }
+
  public:
   // Convenience
 
   static auto from(std::istream& input) -> Grid {
-    auto filter_newlines = [](auto chr) { return chr != '\n'; };
-    auto chars           = std::string{};
+    auto chars = std::string{};
     std::getline(input, chars, '\0');
-    const auto width = chars.find('\n');
-    return Grid{width, chars | std::views::filter(filter_newlines)};
+    return from(std::string_view{chars});
+  }
+
+  static auto from(std::string_view chars) -> Grid
+    requires std::is_same_v<STORE_AS, char>
+  {
+    // The newlines are dropped and the remaining cells wrap at the width of
+    // the first line; a partial last row is cut off
+    const auto lines = LineIndex{chars};
+    const auto width = lines.empty() ? size_t{} : lines.front().size();
+    auto cells       = size_t{};
+    for (const auto line : lines) cells += line.size();
+    const auto height = width == 0 ? size_t{} : cells / width;
+
+    auto grid = Grid{width, height};
+    auto x    = size_t{};
+    auto y    = size_t{};
+    for (auto line : lines) {
+      while (not line.empty() and y != height) {
+        const auto run = line.substr(0, width - x);
+        if constexpr (LAYOUT::contiguous_rows) {
+          std::ranges::copy(run, grid.data_.begin() + static_cast<ptrdiff_t>(
+                                                         grid.offsetOf(x, y)));
+        } else {
+          for (size_t i = 0; i != run.size(); ++i)
+            grid.data_[grid.offsetOf(x + i, y)] = run[i];
+        }
+        line.remove_prefix(run.size());
+        x += run.size();
+        if (x == width) {
+          x = 0;
+          ++y;
+        }
+      }
+    }
+    return grid;
   }
 
   // Constructors
 
-  Grid(size_t width, size_t height)
-      : width_{width}, height_{height}, data_(width * height) {}
+  Grid(size_t width, size_t height) : width_{width}, height_{height} {
+    place(std::vector<STORE_AS>(width * height));
+  }
 
   template <typename CHARACTER_RANGE>
     requires std::is_same_v<STORE_AS, char>
   Grid(size_t width, CHARACTER_RANGE&& input_range)
       : width_{width}, data_{std::begin(input_range), std::end(input_range)} {
     height_ = data_.size() / width_;
+    place(std::exchange(data_, {}));
   }
 
   template <typename CHARACTER_RANGE,
@@ -86,7 +269,9 @@ class Grid {
       : width_{width} {
     const auto distance = std::ranges::distance(input_range);
     height_             = distance / width_;
-    for (auto&& element : input_range) data_.push_back(convert(element));
+    auto cells = std::vector<STORE_AS>{};
+    for (auto&& element : input_range) cells.push_back(convert(element));
+    place(std::move(cells));
   }
 
   // Data access
@@ -96,7 +281,7 @@ class Grid {
       if (!inBounds(Coordinate{static_cast<int>(x), static_cast<int>(y)}))
         return OOB_POLICY::outOfBounds();
     }
-    return data_[y * width_ + x];
+    return data_[offsetOf(x, y)];
   }
 
   [[nodiscard]] constexpr auto operator[](size_t x,
@@ -105,15 +290,14 @@ class Grid {
       if (!inBounds(Coordinate{static_cast<int>(x), static_cast<int>(y)}))
         return OOB_POLICY::outOfBounds();
     }
-    return data_[y * width_ + x];
+    return data_[offsetOf(x, y)];
   }
 
   [[nodiscard]] constexpr auto operator[](Coordinate coordinate) -> STORE_AS& {
     if constexpr (OOB_POLICY::check_bounds) {
       if (!inBounds(coordinate)) return OOB_POLICY::outOfBounds();
     }
-    return data_[static_cast<size_t>(coordinate.y) * width_ +
-                 static_cast<size_t>(coordinate.x)];
+    return data_[offsetOf(coordinate)];
   }
 
   [[nodiscard]] constexpr auto operator[](Coordinate coordinate) const
@@ -121,8 +305,7 @@ class Grid {
     if constexpr (OOB_POLICY::check_bounds) {
       if (!inBounds(coordinate)) return OOB_POLICY::outOfBounds();
     }
-    return data_[static_cast<size_t>(coordinate.y) * width_ +
-                 static_cast<size_t>(coordinate.x)];
+    return data_[offsetOf(coordinate)];
   }
 
   // Utility
@@ -136,7 +319,21 @@ class Grid {
            coordinate.y >= 0 and static_cast<size_t>(coordinate.y) < height_;
   }
 
-  void clear() { std::fill(data_.begin(), data_.end(), STORE_AS{}); }
+  void clear() { fill(STORE_AS{}); }
+
+  void fill(const STORE_AS& value) {
+    if constexpr (BORDER == 0) {
+      std::ranges::fill(data_, value);
+    } else if constexpr (LAYOUT::contiguous_rows) {
+      for (size_t y = 0; y != height_; ++y)
+        std::ranges::fill_n(
+            data_.begin() + static_cast<ptrdiff_t>(offsetOf(0, y)),
+            static_cast<ptrdiff_t>(width_), value);
+    } else {
+      for (size_t y = 0; y != height_; ++y)
+        for (size_t x = 0; x != width_; ++x) data_[offsetOf(x, y)] = value;
+    }
+  }
 
   // Coordinate Generators
 
@@ -9,16 +9,19 @@
 
 #include "grid.hh"
 
-template <typename GRID_STORE_AS, typename GRID_OOB_POLICY>
-struct fmt::formatter<Utils::Grid<GRID_STORE_AS, GRID_OOB_POLICY>> {
+template <typename GRID_STORE_AS, typename GRID_OOB_POLICY,
+          typename GRID_LAYOUT>
+struct fmt::formatter<
+    Utils::Grid<GRID_STORE_AS, GRID_OOB_POLICY, GRID_LAYOUT>> {
   template <typename ParseContext>
   constexpr auto parse(ParseContext& ctx) {
     return ctx.begin();
   }
 
   template <typename FormatContext>
-  auto format(const Utils::Grid<GRID_STORE_AS, GRID_OOB_POLICY>& grid,
-              FormatContext& ctx) const {
+  auto format(
+      const Utils::Grid<GRID_STORE_AS, GRID_OOB_POLICY, GRID_LAYOUT>& grid,
+      FormatContext& ctx) const {
     if constexpr (sizeof(GRID_STORE_AS) != 1) {
       const auto columns = std::views::iota(1U, grid.width() + 1);
       fmt::format_to(ctx.out(), "       {:^6}\n", fmt::join(columns, " "));
@@ -0,0 +1,86 @@
+#ifndef UTILS_GRID_GRAPH_HH
+#define UTILS_GRID_GRAPH_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "coordinate.hh"
+#include "coordinate_directions.hh"
+#include "coordinate_indexer.hh"
+#include "grid.hh"
+#include "weighted_edge.hh"
+
+namespace Utils {
+
+// The orthogonal moves between the passable cells of a grid, built once and
+// stored in compressed sparse row form: the moves out of cell i go to
+// targets_[offsets_[i] .. offsets_[i + 1]) with the matching weights_.
+// Cells are indexed with a CoordinateIndexer and with 32 bits.
+//
+// A GridGraph is itself a (visitor) adjacency, so it can be handed straight
+// to the search algorithms along with indexer():
+//   dijkstra(Edge{0, start}, graph, graph.indexer())
+template <typename DISTANCE = int>
+class GridGraph {
+  CoordinateIndexer index_;
+  std::vector<uint32_t> offsets_{0};
+  std::vector<uint32_t> targets_{};
+  std::vector<DISTANCE> weights_{};
+
+ public:
+  using Edge = WeightedEdge<DISTANCE, Coordinate>;
+
+  // weight(from, to) gives the weight of every move between passable cells
+  template <typename STORE_AS, typename OOB_POLICY, typename LAYOUT>
+  GridGraph(const Grid<STORE_AS, OOB_POLICY, LAYOUT>& grid, auto&& passable,
+            auto&& weight)
+      : index_{grid} {
+    offsets_.reserve(index_.size() + 1);
+    for (const auto from : grid.coordinates()) {
+      if (passable(grid[from]))
+        for (const auto direction : Directions::orthogonal()) {
+          const auto to = from + direction;
+          if (!grid.inBounds(to) or !passable(grid[to])) continue;
+          targets_.push_back(static_cast<uint32_t>(index_(to)));
+          weights_.push_back(weight(from, to));
+        }
+      offsets_.push_back(static_cast<uint32_t>(targets_.size()));
+    }
+  }
+
+  // Every move weighs 1
+  template <typename STORE_AS, typename OOB_POLICY, typename LAYOUT>
+  GridGraph(const Grid<STORE_AS, OOB_POLICY, LAYOUT>& grid, auto&& passable)
+      : GridGraph{grid, passable,
+                  [](const Coordinate& /*unused*/,
+                     const Coordinate& /*unused*/) { return DISTANCE{1}; }} {}
+
+  [[nodiscard]] auto indexer() const -> const CoordinateIndexer& {
+    return index_;
+  }
+
+  [[nodiscard]] auto size() const -> size_t { return offsets_.size() - 1; }
+
+  [[nodiscard]] auto targetsAt(size_t idx) const -> std::span<const uint32_t> {
+    return std::span{targets_}.subspan(offsets_[idx],
+                                       offsets_[idx + 1] - offsets_[idx]);
+  }
+
+  [[nodiscard]] auto weightsAt(size_t idx) const -> std::span<const DISTANCE> {
+    return std::span{weights_}.subspan(offsets_[idx],
+                                       offsets_[idx + 1] - offsets_[idx]);
+  }
+
+  // Calls visit(Edge) for every move out of from
+  void operator()(const Coordinate& from, auto&& visit) const {
+    const auto idx = index_(from);
+    for (auto arc = offsets_[idx]; arc != offsets_[idx + 1]; ++arc)
+      visit(Edge{weights_[arc], index_.stateAt(targets_[arc])});
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_GRID_GRAPH_HH
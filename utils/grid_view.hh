@@ -0,0 +1,125 @@
+#ifndef UTILS_GRID_VIEW_HH
+#define UTILS_GRID_VIEW_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include "coordinate.hh"
+#include "grid.hh"
+
+namespace Utils {
+
+// Grid over cells it does not own, such as the bytes of a mapped input file.
+// Row y starts stride cells after row y - 1, so a text grid is viewed in
+// place with a stride of width + 1, stepping over each newline. Out of bounds
+// access is undefined, as for a default Grid.
+//
+// Days that only read a grid can use the view directly; toGrid() makes the
+// owning copy for those that change it.
+template <typename T>
+class GridView {
+  T* data_p_{nullptr};
+  size_t width_{};
+  size_t height_{};
+  size_t stride_{};
+
+  [[nodiscard]] constexpr auto offsetOf(size_t x, size_t y) const -> size_t {
+    return y * stride_ + x;
+  }
+
+ public:
+  constexpr GridView() = default;
+
+  constexpr GridView(T* data, size_t width, size_t height, size_t stride)
+      : data_p_{data}, width_{width}, height_{height}, stride_{stride} {}
+
+  // As for Grid::from(), the width is that of the first line and the height
+  // is the number of cells (every character but the newlines) over the
+  // width, as far as whole rows of the buffer reach. Every row is expected to
+  // be as wide as the first.
+  [[nodiscard]] static constexpr auto from(std::string_view chars) -> GridView
+    requires std::is_same_v<T, const char>
+  {
+    const auto width  = std::min(chars.find('\n'), chars.size());
+    const auto stride = width + 1;
+    if (width == 0) return {chars.data(), 0, 0, stride};
+    const auto cells =
+        chars.size() - static_cast<size_t>(std::ranges::count(chars, '\n'));
+    const auto height = std::min(cells / width, (chars.size() + 1) / stride);
+    return {chars.data(), width, height, stride};
+  }
+
+  // Data access
+
+  [[nodiscard]] constexpr auto operator[](size_t x, size_t y) const -> T& {
+    return data_p_[offsetOf(x, y)];  // NOLINT
+  }
+
+  [[nodiscard]] constexpr auto operator[](Coordinate coordinate) const -> T& {
+    return (*this)[static_cast<size_t>(coordinate.x),
+                   static_cast<size_t>(coordinate.y)];
+  }
+
+  [[nodiscard]] constexpr auto row(size_t y) const -> std::span<T> {
+    return {data_p_ + offsetOf(0, y), width_};  // NOLINT
+  }
+
+  // Utility
+
+  [[nodiscard]] constexpr auto height() const { return height_; };
+
+  [[nodiscard]] constexpr auto width() const { return width_; };
+
+  [[nodiscard]] constexpr auto stride() const { return stride_; };
+
+  [[nodiscard]] constexpr auto inBounds(Coordinate coordinate) const -> bool {
+    return coordinate.x >= 0 and static_cast<size_t>(coordinate.x) < width_ and
+           coordinate.y >= 0 and static_cast<size_t>(coordinate.y) < height_;
+  }
+
+  // Coordinate Generators
+
+  [[nodiscard]] auto coordinates() const {
+    return std::views::cartesian_product(std::views::iota(0U, height_),
+                                         std::views::iota(0U, width_))  //
+           | std::views::transform([](auto&& xy_tuple) {
+               return Coordinate{static_cast<int>(std::get<1>(xy_tuple)),
+                                 static_cast<int>(std::get<0>(xy_tuple))};
+             });
+  }
+
+  // Algorithms
+
+  [[nodiscard]] auto find(const std::remove_const_t<T>& what) const
+      -> std::optional<Coordinate> {
+    for (size_t y = 0; y != height_; ++y) {
+      const auto cells = row(y);
+      if (const auto found = std::ranges::find(cells, what);
+          found != cells.end())
+        return Coordinate{static_cast<int>(found - cells.begin()),
+                          static_cast<int>(y)};
+    }
+    return std::nullopt;
+  }
+
+  // An owning copy, for changing
+  template <typename OOB_POLICY = OutOfBoundsPolicy::Undefined,
+            typename LAYOUT     = Layout::RowMajor>
+  [[nodiscard]] auto toGrid() const
+      -> Grid<std::remove_const_t<T>, OOB_POLICY, LAYOUT> {
+    auto grid = Grid<std::remove_const_t<T>, OOB_POLICY, LAYOUT>{width_,
+                                                                 height_};
+    for (size_t y = 0; y != height_; ++y)
+      for (size_t x = 0; x != width_; ++x) grid[x, y] = (*this)[x, y];
+    return grid;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_GRID_VIEW_HH
@@ -0,0 +1,75 @@
+#ifndef INPLACE_VECTOR_HH
+#define INPLACE_VECTOR_HH
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <ranges>
+#include <utility>
+
+namespace Utils {
+
+// Vector of at most CAPACITY elements stored inline, for small results (such
+// as the adjacent edges of a grid cell) built without allocating
+template <typename T, size_t CAPACITY>
+class InplaceVector {
+  std::array<T, CAPACITY> values_{};
+  size_t size_{};
+
+ public:
+  using value_type     = T;
+  using iterator       = T*;
+  using const_iterator = const T*;
+
+  constexpr InplaceVector() = default;
+
+  template <std::ranges::input_range RANGE>
+  constexpr InplaceVector(std::from_range_t /*unused*/, RANGE&& range) {
+    for (auto&& value : range) push_back(std::forward<decltype(value)>(value));
+  }
+
+  constexpr void push_back(const T& value) {
+    assert(size_ < CAPACITY);
+    values_[size_++] = value;
+  }
+
+  constexpr void push_back(T&& value) {
+    assert(size_ < CAPACITY);
+    values_[size_++] = std::move(value);
+  }
+
+  template <typename... ARGS>
+  constexpr auto emplace_back(ARGS&&... args) -> T& {
+    assert(size_ < CAPACITY);
+    return values_[size_++] = T{std::forward<ARGS>(args)...};
+  }
+
+  constexpr void clear() { size_ = 0; }
+
+  [[nodiscard]] constexpr auto operator[](size_t idx) -> T& {
+    return values_[idx];
+  }
+
+  [[nodiscard]] constexpr auto operator[](size_t idx) const -> const T& {
+    return values_[idx];
+  }
+
+  [[nodiscard]] constexpr auto size() const -> size_t { return size_; }
+  [[nodiscard]] constexpr auto empty() const -> bool { return size_ == 0; }
+  [[nodiscard]] static constexpr auto capacity() -> size_t { return CAPACITY; }
+
+  [[nodiscard]] constexpr auto begin() -> iterator { return values_.data(); }
+  [[nodiscard]] constexpr auto end() -> iterator {
+    return values_.data() + size_;
+  }
+  [[nodiscard]] constexpr auto begin() const -> const_iterator {
+    return values_.data();
+  }
+  [[nodiscard]] constexpr auto end() const -> const_iterator {
+    return values_.data() + size_;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // INPLACE_VECTOR_HH
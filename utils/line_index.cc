@@ -0,0 +1,77 @@
+#include "line_index.hh"
+
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+void pushBits(std::vector<size_t>& ends, size_t offset, uint32_t mask) {
+  while (mask != 0) {
+    ends.push_back(offset + static_cast<size_t>(std::countr_zero(mask)));
+    mask &= mask - 1;
+  }
+}
+
+// Each of the scanners below returns how many characters they have consumed.
+
+auto scalarNewlines(std::string_view chars, size_t from,
+                    std::vector<size_t>& ends) -> size_t {
+  for (auto idx = from; idx != chars.size(); ++idx)
+    if (chars[idx] == '\n') ends.push_back(idx);
+  return chars.size();
+}
+
+#if defined(__x86_64__)
+
+[[gnu::target("sse2")]] auto sse2Newlines(std::string_view chars,
+                                          std::vector<size_t>& ends) -> size_t {
+  const auto newlines = _mm_set1_epi8('\n');
+  auto idx            = size_t{};
+  for (; idx + 16 <= chars.size(); idx += 16) {
+    const auto block = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(chars.data() + idx));  // NOLINT
+    pushBits(ends, idx,
+             static_cast<uint32_t>(
+                 _mm_movemask_epi8(_mm_cmpeq_epi8(block, newlines))));
+  }
+  return idx;
+}
+
+[[gnu::target("avx2")]] auto avx2Newlines(std::string_view chars,
+                                          std::vector<size_t>& ends) -> size_t {
+  const auto newlines = _mm256_set1_epi8('\n');
+  auto idx            = size_t{};
+  for (; idx + 32 <= chars.size(); idx += 32) {
+    const auto block = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(chars.data() + idx));  // NOLINT
+    pushBits(ends, idx,
+             static_cast<uint32_t>(
+                 _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newlines))));
+  }
+  return idx;
+}
+
+#endif
+
+}  // namespace
+
+namespace Utils {
+
+LineIndex::LineIndex(std::string_view chars) : chars_{chars} {
+  auto scanned = size_t{};
+#if defined(__x86_64__)
+  scanned = __builtin_cpu_supports("avx2") ? avx2Newlines(chars_, ends_)
+                                           : sse2Newlines(chars_, ends_);
+#endif
+  scalarNewlines(chars_, scanned, ends_);
+
+  if (!chars_.empty() and chars_.back() != '\n') ends_.push_back(chars_.size());
+}
+
+}  // namespace Utils
@@ -0,0 +1,138 @@
+#ifndef UTILS_LINE_INDEX_HH
+#define UTILS_LINE_INDEX_HH
+
+#include <compare>  // IWYU pragma: keep
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+namespace Utils {
+
+// Random access index over the lines of a character buffer, built in a single
+// vectorized pass (AVX2 or SSE2, chosen at runtime, with a scalar fallback).
+// Follows std::getline semantics; a trailing newline does not produce an
+// additional empty line.
+class LineIndex {
+  std::string_view chars_{};
+  std::vector<size_t> ends_{};
+
+ public:
+  class Iterator {
+    const LineIndex* index_p_{nullptr};
+    std::ptrdiff_t idx_{};
+
+   public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using difference_type  = std::ptrdiff_t;
+    using value_type       = std::string_view;
+
+    Iterator() = default;
+
+    constexpr Iterator(const LineIndex* index, std::ptrdiff_t idx)
+        : index_p_{index}, idx_{idx} {}
+
+    [[nodiscard]] constexpr auto operator*() const -> std::string_view {
+      return (*index_p_)[static_cast<size_t>(idx_)];
+    }
+
+    [[nodiscard]] constexpr auto operator[](difference_type offset) const
+        -> std::string_view {
+      return *(*this + offset);
+    }
+
+    constexpr auto operator++() -> Iterator& {
+      ++idx_;
+      return *this;
+    }
+
+    constexpr auto operator++(int) -> Iterator {
+      const auto pre = *this;
+      ++idx_;
+      return pre;
+    }
+
+    constexpr auto operator--() -> Iterator& {
+      --idx_;
+      return *this;
+    }
+
+    constexpr auto operator--(int) -> Iterator {
+      const auto pre = *this;
+      --idx_;
+      return pre;
+    }
+
+    constexpr auto operator+=(difference_type offset) -> Iterator& {
+      idx_ += offset;
+      return *this;
+    }
+
+    constexpr auto operator-=(difference_type offset) -> Iterator& {
+      idx_ -= offset;
+      return *this;
+    }
+
+    [[nodiscard]] friend constexpr auto operator+(Iterator it,
+                                                  difference_type offset)
+        -> Iterator {
+      return it += offset;
+    }
+
+    [[nodiscard]] friend constexpr auto operator+(difference_type offset,
+                                                  Iterator it) -> Iterator {
+      return it += offset;
+    }
+
+    [[nodiscard]] friend constexpr auto operator-(Iterator it,
+                                                  difference_type offset)
+        -> Iterator {
+      return it -= offset;
+    }
+
+    [[nodiscard]] friend constexpr auto operator-(const Iterator& lhs,
+                                                  const Iterator& rhs)
+        -> difference_type {
+      return lhs.idx_ - rhs.idx_;
+    }
+
+    [[nodiscard]] constexpr auto operator==(const Iterator& other) const
+        -> bool {
+      return idx_ == other.idx_;
+    }
+
+    [[nodiscard]] constexpr auto operator<=>(const Iterator& other) const {
+      return idx_ <=> other.idx_;
+    }
+  };
+
+  LineIndex() = default;
+
+  explicit LineIndex(std::string_view chars);
+
+  [[nodiscard]] constexpr auto operator[](size_t line) const
+      -> std::string_view {
+    const auto start = line == 0 ? size_t{} : ends_[line - 1] + 1;
+    return chars_.substr(start, ends_[line] - start);
+  }
+
+  [[nodiscard]] constexpr auto size() const -> size_t { return ends_.size(); }
+
+  [[nodiscard]] constexpr auto empty() const -> bool { return ends_.empty(); }
+
+  [[nodiscard]] constexpr auto front() const -> std::string_view {
+    return (*this)[0];
+  }
+
+  [[nodiscard]] constexpr auto begin() const -> Iterator {
+    return Iterator{this, 0};
+  }
+
+  [[nodiscard]] constexpr auto end() const -> Iterator {
+    return Iterator{this, static_cast<std::ptrdiff_t>(ends_.size())};
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_LINE_INDEX_HH
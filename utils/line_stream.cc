@@ -0,0 +1,77 @@
+#include "line_stream.hh"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string_view>
+
+namespace Utils {
+
+LineStream::LineStream(const std::filesystem::path& path, size_t chunk_size)
+    : file_{path, std::ios_base::binary},
+      window_(2 * chunk_size),
+      chunk_size_{chunk_size} {}
+
+auto LineStream::refill() -> bool {
+  if (!file_.good()) return false;
+
+  // Carry the partial line to the front of the window
+  std::copy(window_.begin() + static_cast<std::ptrdiff_t>(begin_),
+            window_.begin() + static_cast<std::ptrdiff_t>(end_),
+            window_.begin());
+  end_ -= begin_;
+  begin_ = 0;
+
+  if (window_.size() - end_ < chunk_size_)
+    window_.resize(window_.size() + chunk_size_);
+
+  file_.read(window_.data() + end_, static_cast<std::streamsize>(chunk_size_));
+  const auto bytes_read = static_cast<size_t>(file_.gcount());
+  end_ += bytes_read;
+  return bytes_read != 0;
+}
+
+auto LineStream::next() -> std::optional<std::string_view> {
+  auto scanned = size_t{};
+  while (true) {
+    const auto pending =
+        std::string_view{window_.data() + begin_, end_ - begin_};
+    const auto newline = pending.find('\n', scanned);
+
+    if (newline != std::string_view::npos) {
+      begin_ += newline + 1;
+      return pending.substr(0, newline);
+    }
+
+    scanned = pending.size();
+    if (!refill()) break;
+  }
+
+  if (begin_ == end_) return std::nullopt;
+  const auto last = std::string_view{window_.data() + begin_, end_ - begin_};
+  begin_          = end_;
+  return last;
+}
+
+auto LineStream::nextLines() -> std::optional<std::string_view> {
+  while (true) {
+    const auto pending =
+        std::string_view{window_.data() + begin_, end_ - begin_};
+    const auto newline = pending.rfind('\n');
+
+    if (newline != std::string_view::npos) {
+      begin_ += newline + 1;
+      return pending.substr(0, newline + 1);
+    }
+
+    if (!refill()) break;
+  }
+
+  if (begin_ == end_) return std::nullopt;
+  const auto last = std::string_view{window_.data() + begin_, end_ - begin_};
+  begin_          = end_;
+  return last;
+}
+
+}  // namespace Utils
@@ -0,0 +1,80 @@
+#ifndef UTILS_LINE_STREAM_HH
+#define UTILS_LINE_STREAM_HH
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace Utils {
+
+// Single pass, bounded memory line reader. The file is read in fixed size
+// chunks into a window of two chunks; a line cut off at the end of a chunk is
+// carried to the front of the window before the next chunk is read. The
+// window only grows if a single line is longer than a chunk.
+//
+// Lines returned are only valid until the next line is requested.
+class LineStream {
+  std::ifstream file_;
+  std::vector<char> window_;
+  size_t chunk_size_{};
+  size_t begin_{};
+  size_t end_{};
+
+  auto refill() -> bool;
+
+ public:
+  static constexpr size_t DEFAULT_CHUNK_SIZE = 64ULL * 1024;
+
+  class Iterator {
+    LineStream* stream_p_{nullptr};
+    std::optional<std::string_view> line_{};
+
+    friend LineStream;
+    explicit Iterator(LineStream* stream)
+        : stream_p_{stream}, line_{stream->next()} {}
+
+   public:
+    using difference_type = std::ptrdiff_t;
+    using value_type      = std::string_view;
+
+    Iterator() = default;
+
+    [[nodiscard]] auto operator*() const -> std::string_view { return *line_; }
+
+    auto operator++() -> Iterator& {
+      line_ = stream_p_->next();
+      return *this;
+    }
+
+    void operator++(int) { ++(*this); }
+
+    [[nodiscard]] auto operator==(std::default_sentinel_t /*unused*/) const
+        -> bool {
+      return !line_.has_value();
+    }
+  };
+
+  explicit LineStream(const std::filesystem::path& path,
+                      size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+  [[nodiscard]] auto next() -> std::optional<std::string_view>;
+
+  // All the complete lines in the window (reading another chunk if there are
+  // none), newlines included; only the last line of the file may lack its
+  // newline. For consumers that parse many lines at a time.
+  [[nodiscard]] auto nextLines() -> std::optional<std::string_view>;
+
+  [[nodiscard]] auto begin() -> Iterator { return Iterator{this}; }
+
+  [[nodiscard]] auto end() const -> std::default_sentinel_t {
+    return std::default_sentinel;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_LINE_STREAM_HH
@@ -0,0 +1,48 @@
+#include "mapped_file.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <utility>
+
+namespace Utils {
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+  const auto fd = ::open(path.c_str(), O_RDONLY);  // NOLINT
+  if (fd == -1) return;
+
+  struct stat status {};
+  if (::fstat(fd, &status) == 0 and status.st_size > 0) {
+    const auto size = static_cast<size_t>(status.st_size);
+    auto* mapped    = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped != MAP_FAILED) {
+      ::madvise(mapped, size, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(mapped);
+      size_ = size;
+    }
+  }
+
+  ::close(fd);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_{std::exchange(other.data_, nullptr)},
+      size_{std::exchange(other.size_, 0)} {}
+
+auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+  if (this != &other) {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr)
+    ::munmap(const_cast<char*>(data_), size_);  // NOLINT
+}
+
+}  // namespace Utils
@@ -0,0 +1,134 @@
+#ifndef UTILS_MAPPED_FILE_HH
+#define UTILS_MAPPED_FILE_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string_view>
+
+namespace Utils {
+
+// Lazily splits a character buffer on '\n'. Follows std::getline semantics;
+// a trailing newline does not produce an additional empty line.
+class LineView : public std::ranges::view_interface<LineView> {
+  std::string_view chars_{};
+
+ public:
+  class Iterator {
+    std::string_view remaining_{};
+    size_t length_{};
+
+    friend LineView;
+    constexpr explicit Iterator(std::string_view remaining)
+        : remaining_{remaining}, length_{lengthOf(remaining)} {}
+
+    [[nodiscard]] static constexpr auto lengthOf(std::string_view chars)
+        -> size_t {
+      return std::min(chars.find('\n'), chars.size());
+    }
+
+   public:
+    using iterator_concept = std::forward_iterator_tag;
+    using difference_type  = std::ptrdiff_t;
+    using value_type       = std::string_view;
+
+    Iterator() = default;
+
+    [[nodiscard]] constexpr auto operator*() const -> std::string_view {
+      return remaining_.substr(0, length_);
+    }
+
+    constexpr auto operator++() -> Iterator& {
+      remaining_.remove_prefix(std::min(length_ + 1, remaining_.size()));
+      length_ = lengthOf(remaining_);
+      return *this;
+    }
+
+    constexpr auto operator++(int) -> Iterator {
+      const auto pre = *this;
+      ++(*this);
+      return pre;
+    }
+
+    [[nodiscard]] constexpr auto operator==(const Iterator& other) const
+        -> bool {
+      return remaining_.data() == other.remaining_.data();
+    }
+
+    [[nodiscard]] constexpr auto operator==(
+        std::default_sentinel_t /*unused*/) const -> bool {
+      return remaining_.empty();
+    }
+  };
+
+  constexpr LineView() = default;
+
+  constexpr explicit LineView(std::string_view chars) : chars_{chars} {}
+
+  [[nodiscard]] constexpr auto begin() const -> Iterator {
+    return Iterator{chars_};
+  }
+
+  [[nodiscard]] constexpr auto end() const -> std::default_sentinel_t {
+    return std::default_sentinel;
+  }
+};
+
+// Read-only memory mapping of an entire file. Files that cannot be opened (or
+// are empty) map to an empty buffer.
+class MappedFile {
+  const char* data_{nullptr};
+  size_t size_{};
+
+ public:
+  MappedFile() = default;
+
+  explicit MappedFile(const std::filesystem::path& path);
+
+  MappedFile(const MappedFile&)                    = delete;
+  auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+  auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+  ~MappedFile();
+
+  [[nodiscard]] constexpr auto bytes() const -> std::span<const char> {
+    return {data_, size_};
+  }
+
+  [[nodiscard]] constexpr auto view() const -> std::string_view {
+    return {data_, size_};
+  }
+
+  [[nodiscard]] constexpr operator std::string_view() const {  // NOLINT
+    return view();
+  }
+
+  [[nodiscard]] constexpr auto lines() const -> LineView {
+    return LineView{view()};
+  }
+
+  [[nodiscard]] constexpr auto data() const -> const char* { return data_; }
+
+  [[nodiscard]] constexpr auto size() const -> size_t { return size_; }
+
+  [[nodiscard]] constexpr auto empty() const -> bool { return size_ == 0; }
+
+  [[nodiscard]] constexpr auto begin() const -> const char* { return data_; }
+
+  [[nodiscard]] constexpr auto end() const -> const char* {
+    return data_ + size_;  // NOLINT
+  }
+};
+
+}  // namespace Utils
+
+template <>
+inline constexpr bool std::ranges::enable_borrowed_range<Utils::LineView> =
+    true;
+
+#endif  // UTILS_MAPPED_FILE_HH
@@ -0,0 +1,110 @@
+#include "parse_integers.hh"
+
+#include <cstdint>
+#include <string_view>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using Utils::Detail::CharacterMask;
+
+// Each of the classifiers below returns how many characters they have
+// consumed; always a multiple of 64.
+
+auto scalarClassify(std::string_view chars, size_t from, CharacterMask& digits,
+                    CharacterMask& newlines) -> size_t {
+  for (auto idx = from; idx != chars.size(); ++idx) {
+    const auto bit = uint64_t{1} << (idx % 64);
+    if (Utils::Detail::isDigit(chars[idx])) digits[idx / 64] |= bit;
+    if (chars[idx] == '\n') newlines[idx / 64] |= bit;
+  }
+  return chars.size();
+}
+
+#if defined(__x86_64__)
+
+[[gnu::target("sse2")]] auto sse2Classify(std::string_view chars,
+                                          CharacterMask& digits,
+                                          CharacterMask& newlines) -> size_t {
+  const auto below_zero = _mm_set1_epi8('0' - 1);
+  const auto above_nine = _mm_set1_epi8('9' + 1);
+  const auto newline    = _mm_set1_epi8('\n');
+
+  auto idx = size_t{};
+  for (; idx + 64 <= chars.size(); idx += 64) {
+    auto digit_bits   = uint64_t{};
+    auto newline_bits = uint64_t{};
+    for (size_t lane = 0; lane != 4; ++lane) {
+      const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+          chars.data() + idx + lane * 16));  // NOLINT
+      const auto is_digit = _mm_and_si128(_mm_cmpgt_epi8(block, below_zero),
+                                          _mm_cmplt_epi8(block, above_nine));
+      digit_bits |= static_cast<uint64_t>(static_cast<uint16_t>(
+                        _mm_movemask_epi8(is_digit)))
+                    << (lane * 16);
+      newline_bits |= static_cast<uint64_t>(static_cast<uint16_t>(
+                          _mm_movemask_epi8(_mm_cmpeq_epi8(block, newline))))
+                      << (lane * 16);
+    }
+    digits[idx / 64]   = digit_bits;
+    newlines[idx / 64] = newline_bits;
+  }
+  return idx;
+}
+
+[[gnu::target("avx2")]] auto avx2Classify(std::string_view chars,
+                                          CharacterMask& digits,
+                                          CharacterMask& newlines) -> size_t {
+  const auto below_zero = _mm256_set1_epi8('0' - 1);
+  const auto above_nine = _mm256_set1_epi8('9' + 1);
+  const auto newline    = _mm256_set1_epi8('\n');
+
+  auto idx = size_t{};
+  for (; idx + 64 <= chars.size(); idx += 64) {
+    auto digit_bits   = uint64_t{};
+    auto newline_bits = uint64_t{};
+    for (size_t lane = 0; lane != 2; ++lane) {
+      const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+          chars.data() + idx + lane * 32));  // NOLINT
+      const auto is_digit =
+          _mm256_and_si256(_mm256_cmpgt_epi8(block, below_zero),
+                           _mm256_cmpgt_epi8(above_nine, block));
+      digit_bits |= static_cast<uint64_t>(static_cast<uint32_t>(
+                        _mm256_movemask_epi8(is_digit)))
+                    << (lane * 32);
+      newline_bits |=
+          static_cast<uint64_t>(static_cast<uint32_t>(
+              _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline))))
+          << (lane * 32);
+    }
+    digits[idx / 64]   = digit_bits;
+    newlines[idx / 64] = newline_bits;
+  }
+  return idx;
+}
+
+#endif
+
+}  // namespace
+
+namespace Utils::Detail {
+
+void classifyDigits(std::string_view chars, CharacterMask& digits,
+                    CharacterMask& newlines) {
+  chars = chars.substr(0, CLASSIFY_BLOCK_SIZE);
+  digits.fill(0);
+  newlines.fill(0);
+
+  auto classified = size_t{};
+#if defined(__x86_64__)
+  classified = __builtin_cpu_supports("avx2")
+                   ? avx2Classify(chars, digits, newlines)
+                   : sse2Classify(chars, digits, newlines);
+#endif
+  scalarClassify(chars, classified, digits, newlines);
+}
+
+}  // namespace Utils::Detail
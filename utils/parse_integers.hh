@@ -0,0 +1,286 @@
+#ifndef UTILS_PARSE_INTEGERS_HH
+#define UTILS_PARSE_INTEGERS_HH
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "line_stream.hh"
+
+namespace Utils::Detail {
+
+inline constexpr auto CLASSIFY_BLOCK_SIZE = size_t{4096};
+
+// One bit per character; bit N of word W describes character W * 64 + N.
+using CharacterMask = std::array<uint64_t, CLASSIFY_BLOCK_SIZE / 64>;
+
+// Marks the digits and newlines among the first CLASSIFY_BLOCK_SIZE
+// characters. Uses AVX2 or SSE2 when available.
+void classifyDigits(std::string_view chars, CharacterMask& digits,
+                    CharacterMask& newlines);
+
+// Turns consecutive words of a digit mask into the first digit of each number.
+struct NumberStarts {
+  uint64_t carry{};
+
+  [[nodiscard]] constexpr auto operator()(uint64_t digits) -> uint64_t {
+    const auto starts = digits & ~((digits << 1) | carry);
+    carry             = digits >> 63;  // NOLINT
+    return starts;
+  }
+};
+
+// The last digit of each number, given whether the character after the word
+// is a digit
+[[nodiscard]] constexpr auto numberEnds(uint64_t digits, bool digit_after)
+    -> uint64_t {
+  return digits & ~((digits >> 1) | (uint64_t{digit_after} << 63));
+}
+
+[[nodiscard]] constexpr auto isDigit(char chr) -> bool {
+  return chr >= '0' and chr <= '9';
+}
+
+// Value of the last length (1 to 8) digits of eight characters read as a
+// little endian word; three multiply-and-mask steps rather than one per digit.
+// The characters before them are masked off, so they need not be digits.
+[[nodiscard]] constexpr auto swarDigits(uint64_t chunk, size_t length)
+    -> uint64_t {
+  const auto keep = ~uint64_t{} << (8 * (8 - length));
+  chunk           = (chunk & keep) - (0x3030'3030'3030'3030ULL & keep);
+  chunk = ((chunk * 10) + (chunk >> 8)) & 0x00FF'00FF'00FF'00FFULL;
+  chunk = ((chunk * 100) + (chunk >> 16)) & 0x0000'FFFF'0000'FFFFULL;
+  return ((chunk * 10000) + (chunk >> 32)) & 0xFFFF'FFFFULL;
+}
+
+[[nodiscard]] inline auto load64(const char* chars) -> uint64_t {
+  auto word = uint64_t{};
+  std::memcpy(&word, chars, sizeof(word));
+  return word;
+}
+
+// Value of the length digits ending before chars[end]. Up to 16 digits are
+// read from the sixteen characters before end; the second word is only
+// needed for numbers longer than eight digits, which are rare.
+[[nodiscard]] inline auto digitsValue(std::string_view chars, size_t end,
+                                      size_t length) -> uint64_t {
+  if constexpr (std::endian::native == std::endian::little) {
+    if (length <= 16 and end >= 16) {
+      const auto* last = chars.data() + end;  // NOLINT
+      const auto low =
+          swarDigits(load64(last - 8), std::min<size_t>(length, 8));  // NOLINT
+      if (length <= 8) return low;
+      return swarDigits(load64(last - 16), length - 8) *  // NOLINT
+                 100'000'000 +
+             low;
+    }
+  }
+  auto value = uint64_t{};
+  for (auto at = end - length; at != end; ++at)
+    value = value * 10 + static_cast<uint64_t>(chars[at] - '0');
+  return value;
+}
+
+}  // namespace Utils::Detail
+
+namespace Utils {
+
+// All integers of a buffer, stored flat, with one row per line.
+template <typename T>
+  requires std::is_integral_v<T>
+class IntegerRows {
+  std::vector<T> values_{};
+  std::vector<size_t> row_offsets_{0};
+
+ public:
+  class Iterator {
+    const IntegerRows* rows_p_{nullptr};
+    size_t row_{};
+
+   public:
+    using difference_type = std::ptrdiff_t;
+    using value_type      = std::span<const T>;
+
+    Iterator() = default;
+
+    constexpr Iterator(const IntegerRows* rows, size_t row)
+        : rows_p_{rows}, row_{row} {}
+
+    [[nodiscard]] constexpr auto operator*() const -> std::span<const T> {
+      return (*rows_p_)[row_];
+    }
+
+    constexpr auto operator++() -> Iterator& {
+      ++row_;
+      return *this;
+    }
+
+    constexpr auto operator++(int) -> Iterator {
+      const auto pre = *this;
+      ++row_;
+      return pre;
+    }
+
+    [[nodiscard]] constexpr auto operator==(const Iterator&) const
+        -> bool = default;
+  };
+
+  constexpr void reserve(size_t values, size_t rows) {
+    values_.reserve(values);
+    row_offsets_.reserve(rows + 1);
+  }
+
+  // Empties the rows, keeping their storage
+  constexpr void clear() {
+    values_.clear();
+    row_offsets_.assign(1, 0);
+  }
+
+  constexpr void push(T value) { values_.push_back(value); }
+
+  constexpr void endRow() { row_offsets_.push_back(values_.size()); }
+
+  // Ends a row after the first offset values; rows end in order
+  constexpr void endRowAt(size_t offset) { row_offsets_.push_back(offset); }
+
+  [[nodiscard]] constexpr auto operator[](size_t row) const
+      -> std::span<const T> {
+    return std::span{values_}.subspan(
+        row_offsets_[row], row_offsets_[row + 1] - row_offsets_[row]);
+  }
+
+  [[nodiscard]] constexpr auto values() const -> std::span<const T> {
+    return values_;
+  }
+
+  [[nodiscard]] constexpr auto size() const -> size_t {
+    return row_offsets_.size() - 1;
+  }
+
+  [[nodiscard]] constexpr auto empty() const -> bool { return size() == 0; }
+
+  [[nodiscard]] constexpr auto begin() const -> Iterator {
+    return Iterator{this, 0};
+  }
+
+  [[nodiscard]] constexpr auto end() const -> Iterator {
+    return Iterator{this, size()};
+  }
+};
+
+namespace Detail {
+
+// Adds the integers of chars to rows, ending a row at every newline
+template <typename T>
+void appendIntegers(std::string_view chars, IntegerRows<T>& rows) {
+  auto digits        = CharacterMask{};
+  auto newlines      = CharacterMask{};
+  auto number_starts = NumberStarts{};
+  auto open_start    = std::optional<size_t>{};  // Continues in the next word
+  for (size_t block = 0; block < chars.size(); block += CLASSIFY_BLOCK_SIZE) {
+    classifyDigits(chars.substr(block), digits, newlines);
+    const auto next_block = block + CLASSIFY_BLOCK_SIZE;
+    const auto digit_after_block =
+        next_block < chars.size() and isDigit(chars[next_block]);
+
+    for (size_t word = 0; word != digits.size(); ++word) {
+      const auto base        = block + word * 64;
+      const auto digit_after = word + 1 == digits.size()
+                                   ? digit_after_block
+                                   : (digits[word + 1] & 1) != 0;
+      const auto ends        = numberEnds(digits[word], digit_after);
+      const auto before      = rows.values().size();
+      auto starts            = number_starts(digits[word]);
+
+      // Rows end after the numbers that end before their newline
+      for (auto lines = newlines[word]; lines != 0; lines &= lines - 1) {
+        const auto below = (uint64_t{1} << std::countr_zero(lines)) - 1;
+        rows.endRowAt(before +
+                      static_cast<size_t>(std::popcount(ends & below)));
+      }
+
+      // Numbers start and end in turn, so each end closes the earliest start
+      for (auto remaining = ends; remaining != 0; remaining &= remaining - 1) {
+        auto start = size_t{};
+        if (open_start) {
+          start = *open_start;
+          open_start.reset();
+        } else {
+          start = base + static_cast<size_t>(std::countr_zero(starts));
+          starts &= starts - 1;
+        }
+        const auto end =
+            base + static_cast<size_t>(std::countr_zero(remaining)) + 1;
+        const auto value = static_cast<T>(digitsValue(chars, end, end - start));
+        if constexpr (std::is_signed_v<T>) {
+          rows.push(start != 0 and chars[start - 1] == '-'
+                        ? static_cast<T>(-value)
+                        : value);
+        } else {
+          rows.push(value);
+        }
+      }
+      if (starts != 0)
+        open_start = base + static_cast<size_t>(std::countr_zero(starts));
+    }
+  }
+}
+
+}  // namespace Detail
+
+// Parses every run of digits in the buffer (with a leading '-' for signed
+// types); anything else is a delimiter. Each line of input becomes one row,
+// following std::getline semantics.
+template <typename T>
+[[nodiscard]] auto parseIntegers(std::string_view chars) -> IntegerRows<T> {
+  auto digits   = Detail::CharacterMask{};
+  auto newlines = Detail::CharacterMask{};
+
+  // Classifying is cheap compared to growing the output; count first so that
+  // the storage is only allocated once.
+  auto value_count  = size_t{};
+  auto row_count    = size_t{1};
+  auto count_starts = Detail::NumberStarts{};
+  for (size_t block = 0; block < chars.size();
+       block += Detail::CLASSIFY_BLOCK_SIZE) {
+    Detail::classifyDigits(chars.substr(block), digits, newlines);
+    for (size_t word = 0; word != digits.size(); ++word) {
+      const auto starts = count_starts(digits[word]);
+      value_count += static_cast<size_t>(std::popcount(starts));
+      row_count += static_cast<size_t>(std::popcount(newlines[word]));
+    }
+  }
+
+  auto rows = IntegerRows<T>{};
+  rows.reserve(value_count, row_count);
+  Detail::appendIntegers(chars, rows);
+  if (!chars.empty() and chars.back() != '\n') rows.endRow();
+  return rows;
+}
+
+// As above, a window of lines at a time, so that only the integers are held
+// in memory rather than the whole input
+template <typename T>
+[[nodiscard]] auto parseIntegers(LineStream&& lines) -> IntegerRows<T> {
+  auto rows     = IntegerRows<T>{};
+  auto complete = true;
+  while (const auto chars = lines.nextLines()) {
+    Detail::appendIntegers(*chars, rows);
+    complete = chars->back() == '\n';
+  }
+  if (!complete) rows.endRow();
+  return rows;
+}
+
+}  // namespace Utils
+
+#endif  // UTILS_PARSE_INTEGERS_HH
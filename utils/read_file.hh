@@ -3,21 +3,53 @@
 
 #include <filesystem>
 #include <ranges>
-#include <string>
-#include <vector>
+#include <string_view>
+#include <utility>
+
+#include "line_index.hh"
+#include "mapped_file.hh"
 
 namespace Utils {
 
-[[nodiscard]] auto readFile(const std::filesystem::path& path)
-    -> std::vector<char>;
+// Owning, indexed range of the lines of a mapped file. The mapping does not
+// move in memory, so the index remains valid when this object is moved.
+class MappedLines {
+  MappedFile file_;
+  LineIndex index_;
+
+ public:
+  explicit MappedLines(MappedFile file)
+      : file_{std::move(file)}, index_{file_.view()} {}
+
+  [[nodiscard]] auto operator[](size_t line) const -> std::string_view {
+    return index_[line];
+  }
+
+  [[nodiscard]] auto size() const -> size_t { return index_.size(); }
+
+  [[nodiscard]] auto empty() const -> bool { return index_.empty(); }
+
+  [[nodiscard]] auto front() const -> std::string_view {
+    return index_.front();
+  }
+
+  [[nodiscard]] auto begin() const -> LineIndex::Iterator {
+    return index_.begin();
+  }
+
+  [[nodiscard]] auto end() const -> LineIndex::Iterator {
+    return index_.end();
+  }
+};
+
+[[nodiscard]] auto readFile(const std::filesystem::path& path) -> MappedFile;
 
-[[nodiscard]] auto readLines(const std::filesystem::path& path)
-    -> std::vector<std::string>;
+[[nodiscard]] auto readLines(const std::filesystem::path& path) -> MappedLines;
 
 template <typename TRANSFORMER>
 auto readFileXY(const std::filesystem::path& path, TRANSFORMER&& transformer) {
-  const auto lines = readLines(path) | std::views::enumerate;
-  for (const auto& [y, line] : lines) {
+  const auto lines = readLines(path);
+  for (const auto& [y, line] : lines | std::views::enumerate) {
     for (const auto& [x, chr] : line | std::views::enumerate)
       transformer(static_cast<size_t>(x), static_cast<size_t>(y), chr);
   }
@@ -0,0 +1,534 @@
+#ifndef SPARSE_COORDINATE_SET_HH
+#define SPARSE_COORDINATE_SET_HH
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <variant>
+#include <vector>
+
+#include "coordinate.hh"
+
+namespace Utils {
+
+namespace Detail {
+
+// The plane is cut into 256x256 tiles, addressing a cell within a tile with a
+// 16 bit value (row major)
+inline constexpr int TILE_SHIFT      = 8;
+inline constexpr int TILE_SIDE       = 1 << TILE_SHIFT;
+inline constexpr uint32_t TILE_CELLS = TILE_SIDE * TILE_SIDE;
+inline constexpr size_t BITMAP_BYTES = TILE_CELLS / 8;
+inline constexpr size_t ARRAY_LIMIT  = BITMAP_BYTES / sizeof(uint16_t);
+
+// Sorted list of cells, for sparsely populated tiles
+class ArrayContainer {
+  std::vector<uint16_t> cells_{};
+
+ public:
+  [[nodiscard]] auto contains(uint16_t cell) const -> bool {
+    return std::ranges::binary_search(cells_, cell);
+  }
+
+  auto insert(uint16_t cell) -> bool {
+    const auto it = std::ranges::lower_bound(cells_, cell);
+    if (it != cells_.end() and *it == cell) return false;
+    cells_.insert(it, cell);
+    return true;
+  }
+
+  auto erase(uint16_t cell) -> bool {
+    const auto it = std::ranges::lower_bound(cells_, cell);
+    if (it == cells_.end() or *it != cell) return false;
+    cells_.erase(it);
+    return true;
+  }
+
+  [[nodiscard]] auto count() const -> size_t { return cells_.size(); }
+
+  [[nodiscard]] auto bytes() const -> size_t {
+    return cells_.size() * sizeof(uint16_t);
+  }
+
+  // Cells in [from, to)
+  [[nodiscard]] auto count(uint32_t from, uint32_t to) const -> size_t {
+    return static_cast<size_t>(std::ranges::lower_bound(cells_, to) -
+                               std::ranges::lower_bound(cells_, from));
+  }
+
+  // First cell at or after from, TILE_CELLS if there is none
+  [[nodiscard]] auto next(uint32_t from) const -> uint32_t {
+    const auto it = std::ranges::lower_bound(cells_, from);
+    return it == cells_.end() ? TILE_CELLS : *it;
+  }
+};
+
+// One bit per cell, for densely populated tiles. The bits are held out of
+// line, so that a tile is no larger than its other containers.
+class BitmapContainer {
+  static constexpr uint32_t WORD_BITS = 64;
+  std::vector<uint64_t> words_ = std::vector<uint64_t>(TILE_CELLS / WORD_BITS);
+  size_t count_{};
+
+ public:
+  [[nodiscard]] auto contains(uint16_t cell) const -> bool {
+    return ((words_[cell / WORD_BITS] >> (cell % WORD_BITS)) & 1) != 0;
+  }
+
+  auto insert(uint16_t cell) -> bool {
+    const auto bit = uint64_t{1} << (cell % WORD_BITS);
+    auto& word     = words_[cell / WORD_BITS];
+    if ((word & bit) != 0) return false;
+    word |= bit;
+    ++count_;
+    return true;
+  }
+
+  auto erase(uint16_t cell) -> bool {
+    const auto bit = uint64_t{1} << (cell % WORD_BITS);
+    auto& word     = words_[cell / WORD_BITS];
+    if ((word & bit) == 0) return false;
+    word &= ~bit;
+    --count_;
+    return true;
+  }
+
+  [[nodiscard]] auto count() const -> size_t { return count_; }
+
+  [[nodiscard]] static constexpr auto bytes() -> size_t { return BITMAP_BYTES; }
+
+  [[nodiscard]] auto count(uint32_t from, uint32_t to) const -> size_t {
+    auto total = size_t{};
+    for (auto word = from / WORD_BITS; word * WORD_BITS < to; ++word) {
+      auto bits = words_[word];
+      if (word == from / WORD_BITS) bits &= ~uint64_t{} << (from % WORD_BITS);
+      if ((word + 1) * WORD_BITS > to)
+        bits &= ~(~uint64_t{} << (to % WORD_BITS));
+      total += static_cast<size_t>(std::popcount(bits));
+    }
+    return total;
+  }
+
+  [[nodiscard]] auto next(uint32_t from) const -> uint32_t {
+    if (from >= TILE_CELLS) return TILE_CELLS;
+    auto word = from / WORD_BITS;
+    auto bits = words_[word] & (~uint64_t{} << (from % WORD_BITS));
+    while (bits == 0) {
+      if (++word == words_.size()) return TILE_CELLS;
+      bits = words_[word];
+    }
+    return word * WORD_BITS + static_cast<uint32_t>(std::countr_zero(bits));
+  }
+};
+
+// Sorted, disjoint runs of consecutive cells, for tiles filled in stretches
+class RunContainer {
+ public:
+  struct Run {
+    uint16_t first{};
+    uint16_t last{};  // Inclusive
+  };
+
+ private:
+  std::vector<Run> runs_{};
+  size_t count_{};
+
+  // First run starting after cell
+  [[nodiscard]] auto after(uint32_t cell) {
+    return std::ranges::upper_bound(runs_, cell, {}, &Run::first);
+  }
+
+  [[nodiscard]] auto after(uint32_t cell) const {
+    return std::ranges::upper_bound(runs_, cell, {}, &Run::first);
+  }
+
+ public:
+  [[nodiscard]] auto contains(uint16_t cell) const -> bool {
+    const auto next = after(cell);
+    return next != runs_.begin() and std::prev(next)->last >= cell;
+  }
+
+  auto insert(uint16_t cell) -> bool {
+    const auto next = after(cell);
+    if (next != runs_.begin() and std::prev(next)->last >= cell) return false;
+
+    const auto extends_previous =
+        next != runs_.begin() and std::prev(next)->last + 1 == cell;
+    const auto extends_next = next != runs_.end() and next->first == cell + 1;
+
+    if (extends_previous and extends_next) {
+      std::prev(next)->last = next->last;
+      runs_.erase(next);
+    } else if (extends_previous) {
+      std::prev(next)->last = cell;
+    } else if (extends_next) {
+      next->first = cell;
+    } else {
+      runs_.insert(next, Run{.first = cell, .last = cell});
+    }
+    ++count_;
+    return true;
+  }
+
+  auto erase(uint16_t cell) -> bool {
+    const auto next = after(cell);
+    if (next == runs_.begin() or std::prev(next)->last < cell) return false;
+
+    const auto run = std::prev(next);
+    if (run->first == run->last) {
+      runs_.erase(run);
+    } else if (run->first == cell) {
+      ++run->first;
+    } else if (run->last == cell) {
+      --run->last;
+    } else {
+      const auto split = Run{.first = static_cast<uint16_t>(cell + 1),
+                             .last  = run->last};
+      run->last        = static_cast<uint16_t>(cell - 1);
+      runs_.insert(next, split);
+    }
+    --count_;
+    return true;
+  }
+
+  [[nodiscard]] auto count() const -> size_t { return count_; }
+
+  [[nodiscard]] auto bytes() const -> size_t {
+    return runs_.size() * sizeof(Run);
+  }
+
+  [[nodiscard]] auto count(uint32_t from, uint32_t to) const -> size_t {
+    auto run = after(from);
+    if (run != runs_.begin() and std::prev(run)->last >= from) --run;
+    auto total = size_t{};
+    for (; run != runs_.end() and run->first < to; ++run)
+      total += std::min<uint32_t>(run->last + 1U, to) -
+               std::max<uint32_t>(run->first, from);
+    return total;
+  }
+
+  [[nodiscard]] auto next(uint32_t from) const -> uint32_t {
+    if (from >= TILE_CELLS) return TILE_CELLS;
+    const auto next = after(from);
+    if (next != runs_.begin() and std::prev(next)->last >= from) return from;
+    return next == runs_.end() ? TILE_CELLS : next->first;
+  }
+};
+
+using TileContainer =
+    std::variant<ArrayContainer, BitmapContainer, RunContainer>;
+
+template <typename CONTAINER>
+[[nodiscard]] auto convertTo(const auto& from) -> CONTAINER {
+  auto to = CONTAINER{};
+  for (auto cell = from.next(0); cell != TILE_CELLS; cell = from.next(cell + 1))
+    to.insert(static_cast<uint16_t>(cell));
+  return to;
+}
+
+// Re-encodes a tile in whichever container takes the least memory
+[[nodiscard]] inline auto compact(const TileContainer& container)
+    -> TileContainer {
+  return std::visit(
+      [](const auto& from) -> TileContainer {
+        auto count = size_t{};
+        auto runs  = size_t{};
+        for (auto cell = from.next(0); cell != TILE_CELLS;
+             cell      = from.next(cell + 1)) {
+          if (count++ == 0 or !from.contains(static_cast<uint16_t>(cell - 1)))
+            ++runs;
+        }
+
+        const auto array_bytes = count * sizeof(uint16_t);
+        const auto run_bytes   = runs * sizeof(RunContainer::Run);
+        if (run_bytes < std::min(array_bytes, BITMAP_BYTES))
+          return convertTo<RunContainer>(from);
+        if (array_bytes <= BITMAP_BYTES) return convertTo<ArrayContainer>(from);
+        return convertTo<BitmapContainer>(from);
+      },
+      container);
+}
+
+}  // namespace Detail
+
+// Compressed set of coordinates over an unbounded plane. The plane is split
+// into tiles and only populated tiles are stored, each as an array, bitmap or
+// run container depending on its population (in the manner of roaring
+// bitmaps). Iterates in tile order rather than row major order.
+class SparseCoordinateSet {
+  struct Tile {
+    Coordinate key;
+    Detail::TileContainer container;
+  };
+
+  std::vector<Tile> tiles_{};
+  size_t count_{};
+
+  [[nodiscard]] static constexpr auto tileFor(const Coordinate& coordinate)
+      -> Coordinate {
+    return {.x = coordinate.x >> Detail::TILE_SHIFT,
+            .y = coordinate.y >> Detail::TILE_SHIFT};
+  }
+
+  [[nodiscard]] static constexpr auto cellFor(const Coordinate& coordinate)
+      -> uint16_t {
+    constexpr auto MASK = Detail::TILE_SIDE - 1;
+    return static_cast<uint16_t>(((coordinate.y & MASK) << Detail::TILE_SHIFT) |
+                                 (coordinate.x & MASK));
+  }
+
+  [[nodiscard]] static constexpr auto coordinateFor(const Coordinate& tile,
+                                                    uint32_t cell)
+      -> Coordinate {
+    constexpr auto MASK = uint32_t{Detail::TILE_SIDE - 1};
+    return {.x = (tile.x * Detail::TILE_SIDE) + static_cast<int>(cell & MASK),
+            .y = (tile.y * Detail::TILE_SIDE) +
+                 static_cast<int>(cell >> Detail::TILE_SHIFT)};
+  }
+
+  // Index of the tile with key, or of where it would be inserted
+  [[nodiscard]] auto tileIndex(const Coordinate& key) const -> size_t {
+    return static_cast<size_t>(
+        std::ranges::lower_bound(tiles_, key, {}, &Tile::key) -
+        tiles_.begin());
+  }
+
+ public:
+  class Iterator {
+    const SparseCoordinateSet* set_p_{nullptr};
+    size_t tile_{};
+    uint32_t cell_{};
+
+    friend SparseCoordinateSet;
+    explicit Iterator(const SparseCoordinateSet* set, size_t tile)
+        : set_p_{set}, tile_{tile} {
+      seek();
+    }
+
+    // Moves to the first member at or after cell_, moving on to later tiles
+    // (which are never empty) when the current one is exhausted
+    void seek() {
+      const auto& tiles = set_p_->tiles_;
+      for (; tile_ < tiles.size(); ++tile_, cell_ = 0) {
+        cell_ = std::visit(
+            [this](const auto& container) { return container.next(cell_); },
+            tiles[tile_].container);
+        if (cell_ != Detail::TILE_CELLS) return;
+      }
+      cell_ = 0;
+    }
+
+    void advance() {
+      ++cell_;
+      seek();
+    }
+
+   public:
+    using difference_type = int32_t;
+    using value_type      = Coordinate;
+
+    Iterator() = default;
+
+    [[nodiscard]] auto operator*() const -> Coordinate {
+      return coordinateFor(set_p_->tiles_[tile_].key, cell_);
+    }
+
+    auto operator++() -> Iterator& {
+      advance();
+      return *this;
+    }
+
+    auto operator++(int) -> Iterator {
+      const auto pre = *this;
+      advance();
+      return pre;
+    }
+
+    [[nodiscard]] auto operator==(const Iterator&) const -> bool = default;
+  };
+
+  using const_iterator = Iterator;
+  using iterator       = Iterator;
+  using value_type     = Coordinate;
+
+  SparseCoordinateSet() = default;
+
+  explicit SparseCoordinateSet(Coordinate coordinate) { insert(coordinate); }
+
+  template <typename RANGE>
+  SparseCoordinateSet(std::from_range_t /*unused*/, RANGE&& range) {
+    for (auto coordinate : range) insert(coordinate);
+  }
+
+  void insert(const Coordinate& coordinate) {
+    const auto key = tileFor(coordinate);
+    const auto idx = tileIndex(key);
+    if (idx == tiles_.size() or tiles_[idx].key != key) {
+      tiles_.insert(tiles_.begin() + static_cast<std::ptrdiff_t>(idx),
+                    Tile{.key = key, .container = Detail::ArrayContainer{}});
+    }
+
+    auto& container = tiles_[idx].container;
+    if (!std::visit(
+            [&](auto& tile) { return tile.insert(cellFor(coordinate)); },
+            container))
+      return;
+    ++count_;
+
+    // Arrays outgrowing a bitmap are promoted
+    if (const auto* array = std::get_if<Detail::ArrayContainer>(&container);
+        array != nullptr and array->count() > Detail::ARRAY_LIMIT)
+      container = Detail::convertTo<Detail::BitmapContainer>(*array);
+  }
+
+  void erase(const Coordinate& coordinate) {
+    const auto key = tileFor(coordinate);
+    const auto idx = tileIndex(key);
+    if (idx == tiles_.size() or tiles_[idx].key != key) return;
+
+    auto& container = tiles_[idx].container;
+    if (!std::visit([&](auto& tile) { return tile.erase(cellFor(coordinate)); },
+                    container))
+      return;
+    --count_;
+
+    // Empty tiles are dropped, and bitmaps that fit an array are demoted
+    const auto remaining =
+        std::visit([](const auto& tile) { return tile.count(); }, container);
+    if (remaining == 0) {
+      tiles_.erase(tiles_.begin() + static_cast<std::ptrdiff_t>(idx));
+    } else if (const auto* bitmap =
+                   std::get_if<Detail::BitmapContainer>(&container);
+               bitmap != nullptr and remaining <= Detail::ARRAY_LIMIT) {
+      container = Detail::convertTo<Detail::ArrayContainer>(*bitmap);
+    }
+  }
+
+  void clear() {
+    tiles_.clear();
+    count_ = 0;
+  }
+
+  // Re-encodes every tile in its smallest container, converting tiles filled
+  // in stretches into runs. Worth calling once a set is built.
+  void optimize() {
+    for (auto& tile : tiles_) tile.container = Detail::compact(tile.container);
+  }
+
+  [[nodiscard]] auto contains(const Coordinate& coordinate) const -> bool {
+    const auto key = tileFor(coordinate);
+    const auto idx = tileIndex(key);
+    return idx != tiles_.size() and tiles_[idx].key == key and
+           std::visit(
+               [&](const auto& tile) {
+                 return tile.contains(cellFor(coordinate));
+               },
+               tiles_[idx].container);
+  }
+
+  [[nodiscard]] auto operator[](const Coordinate& coordinate) const -> bool {
+    return contains(coordinate);
+  }
+
+  // Cells covered by the populated tiles
+  [[nodiscard]] constexpr auto size() const -> size_t {
+    return tiles_.size() * Detail::TILE_CELLS;
+  }
+
+  [[nodiscard]] constexpr auto count() const -> size_t { return count_; }
+
+  // Number of coordinates in the rectangle [from, to)
+  [[nodiscard]] auto count(Coordinate from, Coordinate to) const -> size_t {
+    auto total = size_t{};
+    for (const auto& tile : tiles_) {
+      // The rectangle in cells of this tile
+      const auto origin = coordinateFor(tile.key, 0);
+      const auto clamp  = [](int value) {
+        return static_cast<uint32_t>(std::clamp(value, 0, Detail::TILE_SIDE));
+      };
+      const auto x_from = clamp(from.x - origin.x);
+      const auto x_to   = clamp(to.x - origin.x);
+      const auto y_from = clamp(from.y - origin.y);
+      const auto y_to   = clamp(to.y - origin.y);
+      if (x_from >= x_to or y_from >= y_to) continue;
+
+      total += std::visit(
+          [&](const auto& container) {
+            auto cells = size_t{};
+            for (auto y = y_from; y != y_to; ++y) {
+              const auto row = y << Detail::TILE_SHIFT;
+              cells += container.count(row + x_from, row + x_to);
+            }
+            return cells;
+          },
+          tile.container);
+    }
+    return total;
+  }
+
+  [[nodiscard]] constexpr auto empty() const -> bool { return count_ == 0; }
+
+  // Bytes held by the containers of the populated tiles
+  [[nodiscard]] auto bytes() const -> size_t {
+    auto total = size_t{};
+    for (const auto& tile : tiles_)
+      total += std::visit(
+          [](const auto& container) { return container.bytes(); },
+          tile.container);
+    return total;
+  }
+
+  // Set algebra
+
+  auto operator|=(const SparseCoordinateSet& other) -> SparseCoordinateSet& {
+    for (const auto coordinate : other) insert(coordinate);
+    return *this;
+  }
+
+  auto operator&=(const SparseCoordinateSet& other) -> SparseCoordinateSet& {
+    auto kept = SparseCoordinateSet{};
+    for (const auto coordinate : *this)
+      if (other.contains(coordinate)) kept.insert(coordinate);
+    return *this = std::move(kept);
+  }
+
+  auto operator-=(const SparseCoordinateSet& other) -> SparseCoordinateSet& {
+    // Erasing would drop tiles from under the iteration
+    if (&other == this) {
+      clear();
+      return *this;
+    }
+    for (const auto coordinate : other) erase(coordinate);
+    return *this;
+  }
+
+  [[nodiscard]] friend auto operator|(SparseCoordinateSet lhs,
+                                      const SparseCoordinateSet& rhs)
+      -> SparseCoordinateSet {
+    return lhs |= rhs;
+  }
+
+  [[nodiscard]] friend auto operator&(SparseCoordinateSet lhs,
+                                      const SparseCoordinateSet& rhs)
+      -> SparseCoordinateSet {
+    return lhs &= rhs;
+  }
+
+  [[nodiscard]] friend auto operator-(SparseCoordinateSet lhs,
+                                      const SparseCoordinateSet& rhs)
+      -> SparseCoordinateSet {
+    return lhs -= rhs;
+  }
+
+  [[nodiscard]] auto begin() const -> Iterator { return Iterator{this, 0}; }
+
+  [[nodiscard]] auto end() const -> Iterator {
+    return Iterator{this, tiles_.size()};
+  }
+};
+
+}  // namespace Utils
+
+#endif  // SPARSE_COORDINATE_SET_HH
@@ -1,9 +1,11 @@
 #ifndef SPLIT_HH
 #define SPLIT_HH
 
+#include <algorithm>
 #include <array>
 #include <charconv>
-#include <string>
+#include <iterator>
+#include <ranges>
 #include <string_view>
 #include <vector>
 
@@ -47,24 +49,114 @@ template <typename T>
   return values;
 }
 
-[[nodiscard]] constexpr auto str_split(std::string_view str,
-                                       std::string_view delimiter)
-    -> std::vector<std::string> {
-  auto values = std::vector<std::string>{};
-  while (!str.empty()) {
-    const auto delimiter_at = str.find(delimiter);
-    auto value              = std::string{};
-    if (delimiter_at != std::string_view::npos) {
-      values.emplace_back(str.begin(), delimiter_at);
-      str.remove_prefix(delimiter_at + delimiter.length());
-    } else {
-      values.emplace_back(str.begin(), str.end());
-      str = {};
+// Lazily splits a string on a delimiter, yielding string_views into it. Like
+// split<T>(), a trailing delimiter does not produce an empty token. Usable in
+// constant expressions.
+class split_sv_view : public std::ranges::view_interface<split_sv_view> {
+  std::string_view str_{};
+  std::string_view delimiter_{};
+
+ public:
+  class Iterator {
+    std::string_view remaining_{};
+    std::string_view delimiter_{};
+    size_t length_{};
+
+    friend split_sv_view;
+    constexpr Iterator(std::string_view remaining, std::string_view delimiter)
+        : remaining_{remaining},
+          delimiter_{delimiter},
+          length_{tokenLength()} {}
+
+    // An empty delimiter never splits, so the string is a single token
+    [[nodiscard]] constexpr auto tokenLength() const -> size_t {
+      if (delimiter_.empty()) return remaining_.size();
+      return std::min(remaining_.find(delimiter_), remaining_.size());
+    }
+
+   public:
+    using iterator_concept = std::forward_iterator_tag;
+    using difference_type  = std::ptrdiff_t;
+    using value_type       = std::string_view;
+
+    Iterator() = default;
+
+    [[nodiscard]] constexpr auto operator*() const -> std::string_view {
+      return remaining_.substr(0, length_);
+    }
+
+    constexpr auto operator++() -> Iterator& {
+      remaining_.remove_prefix(
+          std::min(length_ + delimiter_.length(), remaining_.size()));
+      length_ = tokenLength();
+      return *this;
+    }
+
+    constexpr auto operator++(int) -> Iterator {
+      const auto pre = *this;
+      ++(*this);
+      return pre;
+    }
+
+    [[nodiscard]] constexpr auto operator==(const Iterator& other) const
+        -> bool {
+      return remaining_.data() == other.remaining_.data();
+    }
+
+    [[nodiscard]] constexpr auto operator==(
+        std::default_sentinel_t /*unused*/) const -> bool {
+      return remaining_.empty();
     }
+  };
+
+  constexpr split_sv_view() = default;
+
+  constexpr split_sv_view(std::string_view str, std::string_view delimiter)
+      : str_{str}, delimiter_{delimiter} {}
+
+  [[nodiscard]] constexpr auto begin() const -> Iterator {
+    return Iterator{str_, delimiter_};
   }
-  return values;
-}
+
+  [[nodiscard]] constexpr auto end() const -> std::default_sentinel_t {
+    return std::default_sentinel;
+  }
+};
 
 }  // namespace Utils
 
+template <>
+inline constexpr bool std::ranges::enable_borrowed_range<Utils::split_sv_view> =
+    true;
+
+namespace Utils::views {
+
+class split_sv_closure
+    : public std::ranges::range_adaptor_closure<split_sv_closure> {
+  std::string_view delimiter_;
+
+ public:
+  constexpr explicit split_sv_closure(std::string_view delimiter)
+      : delimiter_{delimiter} {}
+
+  [[nodiscard]] constexpr auto operator()(std::string_view str) const {
+    return split_sv_view{str, delimiter_};
+  }
+};
+
+struct split_sv_fn {
+  [[nodiscard]] constexpr auto operator()(std::string_view str,
+                                          std::string_view delimiter) const {
+    return split_sv_view{str, delimiter};
+  }
+
+  [[nodiscard]] constexpr auto operator()(std::string_view delimiter) const {
+    return split_sv_closure{delimiter};
+  }
+};
+
+constexpr inline auto split_sv = split_sv_fn{};
+
+}  // namespace Utils::views
+
 #endif  // SPLIT_HH
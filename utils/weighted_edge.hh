@@ -0,0 +1,20 @@
+#ifndef UTILS_WEIGHTED_EDGE_HH
+#define UTILS_WEIGHTED_EDGE_HH
+
+namespace Utils {
+
+template <typename DISTANCE, typename EDGE>
+struct WeightedEdge {
+  DISTANCE distance;
+  EDGE edge;
+
+  [[nodiscard]] constexpr auto operator<(const WeightedEdge& other) const
+      -> bool {
+    // NOTE(AE): REVERSE ORDERING - MIN ELEMENT FIRST
+    return other.distance < distance;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_WEIGHTED_EDGE_HH